@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <stdint.h>
+
+#include "Iterator.hpp"
+#include "Simd.hpp"
+#include "Vector.hpp"
+
+namespace ft {
+	template <std::size_t Bytes> struct radix_unsigned;
+	template <> struct radix_unsigned<1> { typedef uint8_t type; };
+	template <> struct radix_unsigned<2> { typedef uint16_t type; };
+	template <> struct radix_unsigned<4> { typedef uint32_t type; };
+	template <> struct radix_unsigned<8> { typedef uint64_t type; };
+
+	// Maps an integral key onto an unsigned one with the same ordering: signed
+	// types get their sign bit flipped so that negatives sort first.
+	template <class T>
+	struct radix_encode {
+		typedef typename radix_unsigned<sizeof(T)>::type	result_type;
+
+		result_type operator()(T value) const {
+			result_type u = static_cast<result_type>(value);
+			if (T(-1) < T(0))
+				u ^= result_type(1) << (sizeof(T) * 8 - 1);
+			return u;
+		}
+	};
+
+	template <class T, class Key>
+	struct radix_encode_key {
+		Key	key;
+		typedef typename radix_encode<typename Key::result_type>::result_type	result_type;
+		result_type operator()(const T &value) const
+			{ return radix_encode<typename Key::result_type>()(key(value)); }
+	};
+
+	// Result type of a key extractor applied to T. Before C++11 the extractor has
+	// to be a function pointer or declare `result_type`.
+	template <class Key, class T>
+	struct key_result {
+#if __cplusplus >= 201103L
+		typedef typename std::decay<decltype(std::declval<Key>()(std::declval<const T&>()))>::type	type;
+#else
+		typedef typename Key::result_type	type;
+#endif
+	};
+#if __cplusplus < 201103L
+	template <class R, class A, class T>
+	struct key_result<R (*)(A), T> { typedef R type; };
+#endif
+
+	template <class Key, class T>
+	struct key_function {
+		typedef typename key_result<Key, T>::type	result_type;
+		Key	key;
+		result_type operator()(const T &value) const { return key(value); }
+	};
+
+	template <class Key, class T>
+	struct key_less {
+		Key	key;
+		bool operator()(const T &lhs, const T &rhs) const { return key(lhs) < key(rhs); }
+	};
+
+	// Ranges shorter than this go to the comparison sort.
+	static const std::size_t	radix_threshold = 64;
+
+	template <class InputIt, class OutputIt, class Encode>
+	void radix_scatter(InputIt src, std::size_t n, OutputIt dst, Encode encode,
+					   std::size_t *offsets, unsigned shift, std::size_t mask) {
+		for (std::size_t i = 0; i < n; ++i, ++src)
+			dst[offsets[(encode(*src) >> shift) & mask]++] = FT_MOVE(*src);
+	}
+
+	// LSD radix sort keyed by encode(element), which returns an unsigned integer.
+	// Digits are 8 bits for short ranges and 11 bits otherwise, which keeps one
+	// pass's histogram within L1. All histograms are built in a single read and
+	// passes whose digit is equal for every element are skipped. Stable.
+	template <class RandomIt, class Encode>
+	void radix_sort(RandomIt first, RandomIt last, Encode encode) {
+		typedef typename ft::iterator_traits<RandomIt>::value_type	value_type;
+		typedef typename Encode::result_type						key_type;
+
+		std::size_t n = last - first;
+		const unsigned key_bits = sizeof(key_type) * 8;
+		const unsigned digit_bits = (key_bits > 8 && n >= (1u << 16)) ? 11 : 8;
+		const std::size_t buckets = std::size_t(1) << digit_bits;
+		const std::size_t mask = buckets - 1;
+		const unsigned passes = (key_bits + digit_bits - 1) / digit_bits;
+
+		ft::Vector<std::size_t> counts(passes * buckets, 0);
+		RandomIt it = first;
+		for (std::size_t i = 0; i < n; ++i, ++it) {
+			key_type key = encode(*it);
+			for (unsigned p = 0; p < passes; ++p)
+				++counts[p * buckets + ((key >> (p * digit_bits)) & mask)];
+		}
+
+		ft::Vector<value_type> scratch;
+		bool in_scratch = false;
+		key_type first_key = encode(*first);
+		for (unsigned p = 0; p < passes; ++p) {
+			std::size_t *count = counts.data() + p * buckets;
+			unsigned shift = p * digit_bits;
+			if (count[(first_key >> shift) & mask] == n)
+				continue;
+			std::size_t sum = 0;
+			for (std::size_t b = 0; b < buckets; ++b) {
+				std::size_t c = count[b];
+				count[b] = sum;
+				sum += c;
+			}
+			if (scratch.empty())
+				scratch.assign(first, last);
+			if (in_scratch)
+				radix_scatter(scratch.data(), n, first, encode, count, shift, mask);
+			else
+				radix_scatter(first, n, scratch.data(), encode, count, shift, mask);
+			in_scratch = !in_scratch;
+		}
+		if (in_scratch)
+			std::copy(scratch.begin(), scratch.end(), first);
+	}
+
+	template <class RandomIt, class Compare>
+	void insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+		typedef typename ft::iterator_traits<RandomIt>::value_type	value_type;
+		if (first == last)
+			return;
+		for (RandomIt i = first + 1; i != last; ++i) {
+			value_type value(FT_MOVE(*i));
+			RandomIt j = i;
+			for (; j != first && comp(value, *(j - 1)); --j)
+				*j = FT_MOVE(*(j - 1));
+			*j = FT_MOVE(value);
+		}
+	}
+
+	template <class RandomIt, class Compare>
+	void introsort_loop(RandomIt first, RandomIt last, std::size_t depth, Compare comp) {
+		typedef typename ft::iterator_traits<RandomIt>::value_type	value_type;
+		while (last - first > 16) {
+			if (!depth--) {
+				std::make_heap(first, last, comp);
+				std::sort_heap(first, last, comp);
+				return;
+			}
+			RandomIt mid = first + (last - first) / 2;
+			RandomIt back = last - 1;
+			if (comp(*mid, *first))
+				std::iter_swap(mid, first);
+			if (comp(*back, *mid)) {
+				std::iter_swap(back, mid);
+				if (comp(*mid, *first))
+					std::iter_swap(mid, first);
+			}
+			value_type pivot(*mid);
+			RandomIt lo = first;
+			RandomIt hi = last;
+			for (;;) {
+				while (comp(*lo, pivot))
+					++lo;
+				--hi;
+				while (comp(pivot, *hi))
+					--hi;
+				if (!(lo < hi))
+					break;
+				std::iter_swap(lo, hi);
+				++lo;
+			}
+			// Recurse into the smaller half, loop on the larger one.
+			if (lo - first < last - lo) {
+				introsort_loop(first, lo, depth, comp);
+				first = lo;
+			} else {
+				introsort_loop(lo, last, depth, comp);
+				last = lo;
+			}
+		}
+		insertion_sort(first, last, comp);
+	}
+
+	// Quicksort with median-of-three pivots that switches to heapsort once the
+	// recursion gets deeper than 2*log2(n), and finishes short runs with
+	// insertion sort. Not stable.
+	template <class RandomIt, class Compare>
+	void introsort(RandomIt first, RandomIt last, Compare comp) {
+		std::size_t depth = 0;
+		for (std::size_t n = last - first; n > 1; n >>= 1)
+			depth += 2;
+		introsort_loop(first, last, depth, comp);
+	}
+
+	template <class RandomIt>
+	void sort_dispatch(RandomIt first, RandomIt last, ft::integral_constant<bool, true>) {
+		typedef typename ft::iterator_traits<RandomIt>::value_type	value_type;
+		if ((std::size_t)(last - first) < radix_threshold)
+			ft::introsort(first, last, std::less<value_type>());
+		else
+			ft::radix_sort(first, last, radix_encode<value_type>());
+	}
+
+	template <class RandomIt>
+	void sort_dispatch(RandomIt first, RandomIt last, ft::integral_constant<bool, false>) {
+		ft::introsort(first, last, std::less<typename ft::iterator_traits<RandomIt>::value_type>());
+	}
+
+	// Integral elements are radix sorted; everything else goes to introsort.
+	template <class RandomIt>
+	void sort(RandomIt first, RandomIt last) {
+		typedef typename ft::iterator_traits<RandomIt>::value_type	value_type;
+		ft::sort_dispatch(first, last, ft::integral_constant<bool, ft::is_integral<value_type>::value>());
+	}
+
+	template <class RandomIt, class Compare>
+	void sort(RandomIt first, RandomIt last, Compare comp) {
+		ft::introsort(first, last, comp);
+	}
+
+	template <class RandomIt, class Key>
+	void sort_by_key_dispatch(RandomIt first, RandomIt last, Key key, ft::integral_constant<bool, true>) {
+		typedef typename ft::iterator_traits<RandomIt>::value_type	value_type;
+		if ((std::size_t)(last - first) < radix_threshold) {
+			key_less<Key, value_type> less = { key };
+			ft::introsort(first, last, less);
+		} else {
+			radix_encode_key<value_type, key_function<Key, value_type> > encode = { { key } };
+			ft::radix_sort(first, last, encode);
+		}
+	}
+
+	template <class RandomIt, class Key>
+	void sort_by_key_dispatch(RandomIt first, RandomIt last, Key key, ft::integral_constant<bool, false>) {
+		key_less<Key, typename ft::iterator_traits<RandomIt>::value_type> less = { key };
+		ft::introsort(first, last, less);
+	}
+
+	// Orders the range by key(element). Integral keys are radix sorted, which is
+	// stable; other keys are compared with operator< and the order of equal keys
+	// is unspecified.
+	template <class RandomIt, class Key>
+	void sort_by_key(RandomIt first, RandomIt last, Key key) {
+		typedef typename key_result<Key, typename ft::iterator_traits<RandomIt>::value_type>::type	key_type;
+		ft::sort_by_key_dispatch(first, last, key, ft::integral_constant<bool, ft::is_integral<key_type>::value>());
+	}
+
+	// Iterators over contiguous storage, whose ranges can go to the Simd.hpp kernels.
+	template <class It>
+	struct contiguous_iterator { static const bool value = false; };
+	template <class T>
+	struct contiguous_iterator<T*> {
+		static const bool value = true;
+		typedef T element_type;
+		static const T *pointer(T *it) { return it; }
+	};
+	template <class T>
+	struct contiguous_iterator<const T*> {
+		static const bool value = true;
+		typedef T element_type;
+		static const T *pointer(const T *it) { return it; }
+	};
+	template <class T>
+	struct contiguous_iterator<ft::iterator<T*> > {
+		static const bool value = true;
+		typedef T element_type;
+		static const T *pointer(const ft::iterator<T*> &it) { return it.base(); }
+	};
+	template <class T>
+	struct contiguous_iterator<ft::iterator<const T*> > {
+		static const bool value = true;
+		typedef T element_type;
+		static const T *pointer(const ft::iterator<const T*> &it) { return it.base(); }
+	};
+
+	// True when [first, last) is contiguous and holds exactly T, so comparing
+	// against a T in a kernel means the same as comparing element by element.
+	template <class It, class T, bool = contiguous_iterator<It>::value>
+	struct is_simd_range : public integral_constant<bool, false> {};
+	template <class It, class T>
+	struct is_simd_range<It, T, true>
+		: public integral_constant<bool, ft::is_same<typename contiguous_iterator<It>::element_type, T>::value> {};
+
+	template <class InputIt, class T>
+	InputIt find_dispatch(InputIt first, InputIt last, const T &value, ft::integral_constant<bool, true>) {
+		return first + ft::simd_find(contiguous_iterator<InputIt>::pointer(first), last - first, value);
+	}
+
+	template <class InputIt, class T>
+	InputIt find_dispatch(InputIt first, InputIt last, const T &value, ft::integral_constant<bool, false>) {
+		for (; first != last; ++first)
+			if (*first == value)
+				break;
+		return first;
+	}
+
+	template <class InputIt, class T>
+	InputIt find(InputIt first, InputIt last, const T &value) {
+		return ft::find_dispatch(first, last, value, ft::integral_constant<bool, is_simd_range<InputIt, T>::value>());
+	}
+
+	template <class InputIt, class T>
+	std::size_t count_dispatch(InputIt first, InputIt last, const T &value, ft::integral_constant<bool, true>) {
+		return ft::simd_count(contiguous_iterator<InputIt>::pointer(first), last - first, value);
+	}
+
+	template <class InputIt, class T>
+	std::size_t count_dispatch(InputIt first, InputIt last, const T &value, ft::integral_constant<bool, false>) {
+		std::size_t n = 0;
+		for (; first != last; ++first)
+			if (*first == value)
+				++n;
+		return n;
+	}
+
+	template <class InputIt, class T>
+	std::size_t count(InputIt first, InputIt last, const T &value) {
+		return ft::count_dispatch(first, last, value, ft::integral_constant<bool, is_simd_range<InputIt, T>::value>());
+	}
+
+	template <class ForwardIt>
+	ft::pair<typename contiguous_iterator<ForwardIt>::element_type, typename contiguous_iterator<ForwardIt>::element_type>
+	min_max_dispatch(ForwardIt first, ForwardIt last, ft::integral_constant<bool, true>) {
+		return ft::simd_min_max(contiguous_iterator<ForwardIt>::pointer(first), last - first);
+	}
+
+	template <class ForwardIt>
+	ft::pair<typename ft::iterator_traits<ForwardIt>::value_type, typename ft::iterator_traits<ForwardIt>::value_type>
+	min_max_dispatch(ForwardIt first, ForwardIt last, ft::integral_constant<bool, false>) {
+		typedef typename ft::iterator_traits<ForwardIt>::value_type	value_type;
+		ft::pair<value_type, value_type> result(*first, *first);
+		for (++first; first != last; ++first) {
+			if (*first < result.first)
+				result.first = *first;
+			if (result.second < *first)
+				result.second = *first;
+		}
+		return result;
+	}
+
+	// Smallest and largest value of a non-empty range.
+	template <class ForwardIt>
+	ft::pair<typename ft::iterator_traits<ForwardIt>::value_type, typename ft::iterator_traits<ForwardIt>::value_type>
+	min_max(ForwardIt first, ForwardIt last) {
+		return ft::min_max_dispatch(first, last, ft::integral_constant<bool, contiguous_iterator<ForwardIt>::value>());
+	}
+}
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "Stats.hpp"
+#include "Utility.hpp"
+#include "Vector.hpp"
+
+namespace ft {
+	// malloc/realloc based allocator. Vectors of trivially copyable types grow through
+	// realloc, which extends in place when it can and uses mremap for large blocks.
+	template <class T>
+	class malloc_allocator {
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <class U>
+		struct rebind { typedef malloc_allocator<U> other; };
+
+		malloc_allocator() {}
+		malloc_allocator(const malloc_allocator &) {}
+		template <class U>
+		malloc_allocator(const malloc_allocator<U> &) {}
+		~malloc_allocator() {}
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		pointer allocate(size_type n, const void * = 0) {
+			if (n > max_size())
+				throw std::bad_alloc();
+			void *p = std::malloc(n * sizeof(T));
+			if (!p && n)
+				throw std::bad_alloc();
+			return static_cast<pointer>(p);
+		}
+
+		void deallocate(pointer p, size_type) { std::free(p); }
+
+		bool reallocate(pointer &p, size_type, size_type n) {
+			if (!ft::is_trivially_copyable<T>::value)
+				return false;
+			if (n > max_size())
+				throw std::bad_alloc();
+			void *q = std::realloc(p, n * sizeof(T));
+			if (!q)
+				throw std::bad_alloc();
+			p = static_cast<pointer>(q);
+			return true;
+		}
+
+		void construct(pointer p, const_reference value) { new (p) T(value); }
+#if __cplusplus >= 201103L
+		template <class U, class... Args>
+		void construct(U *p, Args&&... args) { new (p) U(std::forward<Args>(args)...); }
+#endif
+		void destroy(pointer p) { p->~T(); }
+		size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+		friend bool operator==(const malloc_allocator &, const malloc_allocator &) { return true; }
+		friend bool operator!=(const malloc_allocator &, const malloc_allocator &) { return false; }
+	};
+
+	template <class T>
+	struct storage_traits<malloc_allocator<T> > : public default_storage_traits<malloc_allocator<T> > {
+		static bool reallocate(malloc_allocator<T>& a, T*& p, std::size_t old_n, std::size_t n)
+			{ return a.reallocate(p, old_n, n); }
+	};
+
+	template <class T>
+	struct is_thread_safe_allocator<malloc_allocator<T> > : public integral_constant<bool, true> {};
+
+	// Stats shared by every default-constructed tracking_allocator.
+	inline allocation_stats &default_allocation_stats() {
+		static allocation_stats stats;
+		return stats;
+	}
+
+	// operator new based allocator that records live bytes, peak bytes and call
+	// counts in an ft::allocation_stats. Rebound copies (the nodes and tree of a
+	// Map or Set) report to the same stats object. Updates are not synchronized.
+	template <class T>
+	class tracking_allocator {
+		template <class U> friend class tracking_allocator;
+
+		allocation_stats	*_stats;
+
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <class U>
+		struct rebind { typedef tracking_allocator<U> other; };
+
+		tracking_allocator() : _stats(&default_allocation_stats()) {}
+		explicit tracking_allocator(allocation_stats &stats) : _stats(&stats) {}
+		tracking_allocator(const tracking_allocator &other) : _stats(other._stats) {}
+		template <class U>
+		tracking_allocator(const tracking_allocator<U> &other) : _stats(other._stats) {}
+		~tracking_allocator() {}
+
+		tracking_allocator &operator=(const tracking_allocator &other)
+			{ _stats = other._stats; return *this; }
+
+		allocation_stats &stats() const { return *_stats; }
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		pointer allocate(size_type n, const void * = 0) {
+			if (n > max_size())
+				throw std::bad_alloc();
+			pointer p = static_cast<pointer>(::operator new(n * sizeof(T)));
+			_stats->allocated(n * sizeof(T));
+			return p;
+		}
+
+		void deallocate(pointer p, size_type n) {
+			::operator delete(p);
+			_stats->deallocated(n * sizeof(T));
+		}
+
+		void construct(pointer p, const_reference value) { new (p) T(value); }
+#if __cplusplus >= 201103L
+		template <class U, class... Args>
+		void construct(U *p, Args&&... args) { new (p) U(std::forward<Args>(args)...); }
+#endif
+		void destroy(pointer p) { p->~T(); }
+		size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+		template <class U>
+		bool operator==(const tracking_allocator<U> &other) const { return _stats == other._stats; }
+		template <class U>
+		bool operator!=(const tracking_allocator<U> &other) const { return _stats != other._stats; }
+	};
+
+	// Page-level storage shared by copies and rebinds of a huge_page_allocator.
+	// Tree nodes and their values are carved from slabs that double from 64 KB up
+	// to 2 MB; 2 MB slabs are 2 MB-aligned and marked MADV_HUGEPAGE. Freed
+	// objects go to a per-size free list, and slabs are unmapped with the arena.
+	// Allocation is locked and the reference count atomic, so an arena may be
+	// shared across threads.
+	class huge_page_arena {
+		struct slab {
+			slab		*next;
+			std::size_t	size;
+		};
+
+	public:
+		enum {
+			cache_line = 64,
+			huge_page = 2 * 1024 * 1024,
+			object_align = 16,
+			max_object = 512,
+			first_slab = 64 * 1024
+		};
+
+	private:
+		void		*_free[max_object / object_align];
+		char		*_next;
+		char		*_end;
+		slab		*_slabs;
+		std::size_t	_next_slab;
+		std::size_t	_refs;
+		pthread_mutex_t	_lock;
+
+		struct guard {
+			pthread_mutex_t	*lock;
+			explicit guard(pthread_mutex_t *l) : lock(l) { pthread_mutex_lock(lock); }
+			~guard() { pthread_mutex_unlock(lock); }
+		};
+
+		huge_page_arena(const huge_page_arena &);
+		huge_page_arena &operator=(const huge_page_arena &);
+
+	public:
+
+		// Anonymous mapping of `bytes`; huge mappings are aligned to a huge page
+		// so the kernel can back them with transparent huge pages.
+		static void *map(std::size_t bytes, bool huge) {
+			std::size_t length = huge ? bytes + huge_page : bytes;
+			void *p = ::mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p == MAP_FAILED)
+				throw std::bad_alloc();
+			if (!huge)
+				return p;
+			char *base = static_cast<char *>(p);
+			char *aligned = reinterpret_cast<char *>((reinterpret_cast<std::size_t>(base) + huge_page - 1) & ~(std::size_t)(huge_page - 1));
+			if (aligned != base)
+				::munmap(base, aligned - base);
+			if (base + length != aligned + bytes)
+				::munmap(aligned + bytes, base + length - (aligned + bytes));
+#ifdef MADV_HUGEPAGE
+			::madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+			return aligned;
+		}
+
+		static void unmap(void *p, std::size_t bytes) { ::munmap(p, bytes); }
+
+		// Starts with one reference, owned by whoever created it.
+		huge_page_arena() : _next(0), _end(0), _slabs(0), _next_slab(first_slab), _refs(1) {
+			for (std::size_t i = 0; i < max_object / object_align; ++i)
+				_free[i] = 0;
+			pthread_mutex_init(&_lock, 0);
+		}
+
+		~huge_page_arena() {
+			while (_slabs) {
+				slab *s = _slabs;
+				_slabs = s->next;
+				unmap(s, s->size);
+			}
+			pthread_mutex_destroy(&_lock);
+		}
+
+		// The arena of every default-constructed huge_page_allocator. Its own
+		// reference is never dropped, so it lives, slabs included, until exit.
+		static huge_page_arena *shared() {
+			static huge_page_arena *arena = new huge_page_arena();
+			return arena;
+		}
+
+		void retain() { __atomic_add_fetch(&_refs, 1, __ATOMIC_RELAXED); }
+		bool release() { return __atomic_sub_fetch(&_refs, 1, __ATOMIC_ACQ_REL) == 0; }
+
+		static std::size_t object_class(std::size_t bytes) { return (bytes + object_align - 1) / object_align - 1; }
+
+		void *allocate(std::size_t bytes) {
+			guard g(&_lock);
+			std::size_t c = object_class(bytes);
+			if (_free[c]) {
+				void *p = _free[c];
+				_free[c] = *static_cast<void **>(p);
+				return p;
+			}
+			std::size_t size = (c + 1) * object_align;
+			if ((std::size_t)(_end - _next) < size) {
+				bool huge = _next_slab >= huge_page;
+				slab *s = static_cast<slab *>(map(_next_slab, huge));
+				s->next = _slabs;
+				s->size = _next_slab;
+				_slabs = s;
+				_next = reinterpret_cast<char *>(s) + cache_line;
+				_end = reinterpret_cast<char *>(s) + _next_slab;
+				if (!huge)
+					_next_slab *= 2;
+			}
+			void *p = _next;
+			_next += size;
+			return p;
+		}
+
+		void deallocate(void *p, std::size_t bytes) {
+			guard g(&_lock);
+			std::size_t c = object_class(bytes);
+			*static_cast<void **>(p) = _free[c];
+			_free[c] = p;
+		}
+	};
+
+	// Allocator for very large containers. Every allocate() is a buffer: 64-byte
+	// aligned, and given its own huge-page mapping from 2 MB up. Tree nodes and
+	// their values of up to 512 bytes are requested through node_storage_traits
+	// instead and come from a huge_page_arena, which packs them densely and keeps
+	// a large tree on few TLB entries. Default-constructed allocators all use
+	// huge_page_arena::shared(); copies and rebinds use the arena of their source.
+	template <class T>
+	class huge_page_allocator {
+		template <class U> friend class huge_page_allocator;
+
+		huge_page_arena	*_arena;
+
+		static bool is_object() { return sizeof(T) <= huge_page_arena::max_object; }
+
+		static std::size_t huge_length(std::size_t bytes)
+			{ return (bytes + huge_page_arena::huge_page - 1) & ~(std::size_t)(huge_page_arena::huge_page - 1); }
+
+		void drop() {
+			if (_arena->release())
+				delete _arena;
+		}
+
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <class U>
+		struct rebind { typedef huge_page_allocator<U> other; };
+
+		huge_page_allocator() : _arena(huge_page_arena::shared()) { _arena->retain(); }
+		// Adopts the reference of a new'd arena; its slabs are unmapped once this
+		// allocator and all its copies are gone.
+		explicit huge_page_allocator(huge_page_arena *arena) : _arena(arena) {}
+		huge_page_allocator(const huge_page_allocator &other) : _arena(other._arena) { _arena->retain(); }
+		template <class U>
+		huge_page_allocator(const huge_page_allocator<U> &other) : _arena(other._arena) { _arena->retain(); }
+		~huge_page_allocator() { drop(); }
+
+		huge_page_allocator &operator=(const huge_page_allocator &other) {
+			other._arena->retain();
+			drop();
+			_arena = other._arena;
+			return *this;
+		}
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		pointer allocate(size_type n, const void * = 0) {
+			if (n > max_size())
+				throw std::bad_alloc();
+			if (!n)
+				return 0;
+			std::size_t bytes = n * sizeof(T);
+			if (bytes >= (std::size_t)huge_page_arena::huge_page)
+				return static_cast<pointer>(huge_page_arena::map(huge_length(bytes), true));
+			void *p = 0;
+			if (::posix_memalign(&p, huge_page_arena::cache_line, bytes) != 0)
+				throw std::bad_alloc();
+			return static_cast<pointer>(p);
+		}
+
+		void deallocate(pointer p, size_type n) {
+			if (!p)
+				return;
+			std::size_t bytes = n * sizeof(T);
+			if (bytes >= (std::size_t)huge_page_arena::huge_page)
+				huge_page_arena::unmap(p, huge_length(bytes));
+			else
+				std::free(p);
+		}
+
+		pointer allocate_object() {
+			if (is_object())
+				return static_cast<pointer>(_arena->allocate(sizeof(T)));
+			return allocate(1);
+		}
+
+		void deallocate_object(pointer p) {
+			if (is_object())
+				_arena->deallocate(p, sizeof(T));
+			else
+				deallocate(p, 1);
+		}
+
+		void construct(pointer p, const_reference value) { new (p) T(value); }
+#if __cplusplus >= 201103L
+		template <class U, class... Args>
+		void construct(U *p, Args&&... args) { new (p) U(std::forward<Args>(args)...); }
+#endif
+		void destroy(pointer p) { p->~T(); }
+		size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+		template <class U>
+		bool operator==(const huge_page_allocator<U> &other) const { return _arena == other._arena; }
+		template <class U>
+		bool operator!=(const huge_page_allocator<U> &other) const { return _arena != other._arena; }
+	};
+
+	template <class T>
+	struct is_thread_safe_allocator<huge_page_allocator<T> > : public integral_constant<bool, true> {};
+
+	template <class T>
+	struct node_storage_traits<huge_page_allocator<T> > {
+		static T *allocate(huge_page_allocator<T> &a) { return a.allocate_object(); }
+		static void deallocate(huge_page_allocator<T> &a, T *p) { a.deallocate_object(p); }
+	};
+}
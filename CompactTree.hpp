@@ -0,0 +1,855 @@
+#pragma once
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+
+#include "Utility.hpp"
+#include "Iterator.hpp"
+
+namespace ft {
+	// 12 bytes of links per element: 32-bit child indices (left, right) and a parent
+	// index whose top bit is the colour. Index 0 is the null link and never holds a value.
+	template <class Value>
+	struct compact_node {
+		uint32_t	child[2];
+		uint32_t	parent;
+		char		storage[sizeof(Value)] __attribute__((aligned(__alignof__(Value))));
+
+		Value *value() { return reinterpret_cast<Value *>(storage); }
+		const Value *value() const { return reinterpret_cast<const Value *>(storage); }
+	};
+
+	// Stores a tree pointer and an index, so it stays valid when the node array
+	// grows; only erasing its own element invalidates it.
+	template <class Tree, class Value>
+	class compact_tree_iterator {
+		template <class, class> friend class compact_tree_iterator;
+
+		Tree		*_tree;
+		uint32_t	_index;
+
+	public:
+		typedef typename Tree::value_type		value_type;
+		typedef std::ptrdiff_t					difference_type;
+		typedef Value&							reference;
+		typedef const Value&					const_reference;
+		typedef Value*							pointer;
+		typedef const Value*					const_pointer;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+
+		compact_tree_iterator(Tree *tree = 0, uint32_t index = 0) : _tree(tree), _index(index) {}
+		compact_tree_iterator(const compact_tree_iterator &other) : _tree(other._tree), _index(other._index) {}
+		template <class T2, class V2>
+		compact_tree_iterator(const compact_tree_iterator<T2, V2> &other,
+							  typename ft::enable_if<std::is_convertible<T2*, Tree*>::value>::type* = 0)
+			: _tree(other._tree), _index(other._index) {}
+
+		compact_tree_iterator &operator=(const compact_tree_iterator &other)
+			{ _tree = other._tree; _index = other._index; return *this; }
+
+		uint32_t index() const { return _index; }
+
+		reference operator*() const { return _tree->value(_index); }
+		pointer operator->() const { return &_tree->value(_index); }
+
+		compact_tree_iterator &operator++() { _index = _tree->next(_index); return *this; }
+		compact_tree_iterator operator++(int) { compact_tree_iterator tmp(*this); ++*this; return tmp; }
+		compact_tree_iterator &operator--() { _index = _tree->prev(_index); return *this; }
+		compact_tree_iterator operator--(int) { compact_tree_iterator tmp(*this); --*this; return tmp; }
+
+		template <class T2, class V2>
+		bool operator==(const compact_tree_iterator<T2, V2> &other) const { return _index == other._index; }
+		template <class T2, class V2>
+		bool operator!=(const compact_tree_iterator<T2, V2> &other) const { return _index != other._index; }
+	};
+
+	// Red-black tree whose nodes live in one growable array and link to each
+	// other by index. Erased slots are kept on a free list and reused by later
+	// inserts. Growing the array moves the values, so pointers and references
+	// to elements are invalidated by inserts; iterators are not.
+	template <class Value, class Key, class KeyOfValue, class Compare, class A>
+	class CompactTree {
+	public:
+		typedef Value											value_type;
+		typedef Key												key_type;
+		typedef Compare											key_compare;
+		typedef A												allocator_type;
+		typedef std::size_t										size_type;
+		typedef uint32_t										index_type;
+		typedef compact_node<Value>								node_type;
+		typedef typename A::template rebind<node_type>::other	allocator_rebind_node;
+
+	private:
+		enum {
+			red_bit = 0x80000000u,
+			index_mask = 0x7fffffffu,
+			free_slot = 0xffffffffu,	// parent link of a slot on the free list
+			max_slots = 0x7fffffffu
+		};
+
+		node_type				*_nodes;
+		index_type				_capacity;
+		index_type				_used;		// slots ever handed out, including slot 0
+		index_type				_free;
+		index_type				_root;
+		index_type				_leftmost;
+		index_type				_rightmost;
+		index_type				_size;
+		allocator_rebind_node	_allocator;
+		Compare					_comp;
+
+		index_type left(index_type i) const { return _nodes[i].child[0]; }
+		index_type right(index_type i) const { return _nodes[i].child[1]; }
+		index_type parent(index_type i) const { return _nodes[i].parent & index_mask; }
+		bool isRed(index_type i) const { return _nodes[i].parent & red_bit; }
+		bool isLive(index_type i) const { return _nodes[i].parent != (uint32_t)free_slot; }
+		void setLeft(index_type i, index_type l) { _nodes[i].child[0] = l; }
+		void setRight(index_type i, index_type r) { _nodes[i].child[1] = r; }
+		void setParent(index_type i, index_type p) { _nodes[i].parent = (_nodes[i].parent & red_bit) | p; }
+		void setRed(index_type i) { _nodes[i].parent |= red_bit; }
+		void setBlack(index_type i) { _nodes[i].parent &= index_mask; }
+		void setColor(index_type i, bool red) { if (red) setRed(i); else setBlack(i); }
+		const Key &key(index_type i) const { return KeyOfValue()(*_nodes[i].value()); }
+
+		index_type minimum(index_type i) const { while (left(i)) i = left(i); return i; }
+		index_type maximum(index_type i) const { while (right(i)) i = right(i); return i; }
+
+		void init() {
+			_nodes = 0;
+			_capacity = 0;
+			_used = 0;
+			_free = 0;
+			_root = 0;
+			_leftmost = 0;
+			_rightmost = 0;
+			_size = 0;
+		}
+
+		void relocate(node_type *dst, ft::integral_constant<bool, true>) {
+			std::memcpy(static_cast<void *>(dst), _nodes, _used * sizeof(node_type));
+		}
+
+		void relocate(node_type *dst, ft::integral_constant<bool, false>) {
+			index_type i = 0;
+			try {
+				for (; i < _used; ++i) {
+					dst[i].child[0] = _nodes[i].child[0];
+					dst[i].child[1] = _nodes[i].child[1];
+					dst[i].parent = _nodes[i].parent;
+					if (i && isLive(i))
+						new (dst[i].value()) Value(FT_MOVE_IF_NOEXCEPT(*_nodes[i].value()));
+				}
+			} catch (...) {
+				while (i-- > 1)
+					if (isLive(i))
+						dst[i].value()->~Value();
+				throw;
+			}
+			destroyValues();
+		}
+
+		void destroyValues() {
+			for (index_type i = 1; i < _used; ++i)
+				if (isLive(i))
+					_nodes[i].value()->~Value();
+		}
+
+		void reallocate(index_type capacity) {
+			node_type *nodes = _allocator.allocate(capacity);
+			if (!_nodes) {
+				nodes[0].child[0] = nodes[0].child[1] = nodes[0].parent = 0;
+				_used = 1;
+			} else {
+				try {
+					relocate(nodes, ft::integral_constant<bool, ft::is_trivially_relocatable<Value>::value>());
+				} catch (...) {
+					_allocator.deallocate(nodes, capacity);
+					throw;
+				}
+				_allocator.deallocate(_nodes, _capacity);
+			}
+			_nodes = nodes;
+			_capacity = capacity;
+		}
+
+		index_type newSlot() {
+			if (_free) {
+				index_type i = _free;
+				_free = left(i);
+				return i;
+			}
+			if (_used == _capacity) {
+				if (_capacity == (index_type)max_slots)
+					throw std::length_error("CompactTree");
+				reallocate(_capacity ? (index_type)std::min<size_type>(size_type(_capacity) * 2, max_slots) : 8);
+			}
+			return _used++;
+		}
+
+		void releaseSlot(index_type i) {
+			_nodes[i].child[0] = _free;
+			_nodes[i].parent = free_slot;
+			_free = i;
+		}
+
+		void replaceChild(index_type p, index_type old_child, index_type new_child) {
+			if (!p)
+				_root = new_child;
+			else if (left(p) == old_child)
+				setLeft(p, new_child);
+			else
+				setRight(p, new_child);
+		}
+
+		void rotateLeft(index_type x) {
+			index_type y = right(x);
+			setRight(x, left(y));
+			if (left(y))
+				setParent(left(y), x);
+			setParent(y, parent(x));
+			replaceChild(parent(x), x, y);
+			setLeft(y, x);
+			setParent(x, y);
+		}
+
+		void rotateRight(index_type x) {
+			index_type y = left(x);
+			setLeft(x, right(y));
+			if (right(y))
+				setParent(right(y), x);
+			setParent(y, parent(x));
+			replaceChild(parent(x), x, y);
+			setRight(y, x);
+			setParent(x, y);
+		}
+
+		void insertFixup(index_type x) {
+			while (x != _root && isRed(parent(x))) {
+				index_type p = parent(x);
+				index_type g = parent(p);
+				if (p == left(g)) {
+					index_type u = right(g);
+					if (u && isRed(u)) {
+						setBlack(p);
+						setBlack(u);
+						setRed(g);
+						x = g;
+					} else {
+						if (x == right(p)) {
+							x = p;
+							rotateLeft(x);
+							p = parent(x);
+						}
+						setBlack(p);
+						setRed(g);
+						rotateRight(g);
+					}
+				} else {
+					index_type u = left(g);
+					if (u && isRed(u)) {
+						setBlack(p);
+						setBlack(u);
+						setRed(g);
+						x = g;
+					} else {
+						if (x == left(p)) {
+							x = p;
+							rotateRight(x);
+							p = parent(x);
+						}
+						setBlack(p);
+						setRed(g);
+						rotateLeft(g);
+					}
+				}
+			}
+			setBlack(_root);
+		}
+
+		// x may be 0, so its parent is tracked separately.
+		void eraseFixup(index_type x, index_type x_parent) {
+			while (x != _root && (!x || !isRed(x))) {
+				if (x == left(x_parent)) {
+					index_type w = right(x_parent);
+					if (isRed(w)) {
+						setBlack(w);
+						setRed(x_parent);
+						rotateLeft(x_parent);
+						w = right(x_parent);
+					}
+					if ((!left(w) || !isRed(left(w))) && (!right(w) || !isRed(right(w)))) {
+						setRed(w);
+						x = x_parent;
+						x_parent = parent(x_parent);
+					} else {
+						if (!right(w) || !isRed(right(w))) {
+							setBlack(left(w));
+							setRed(w);
+							rotateRight(w);
+							w = right(x_parent);
+						}
+						setColor(w, isRed(x_parent));
+						setBlack(x_parent);
+						if (right(w))
+							setBlack(right(w));
+						rotateLeft(x_parent);
+						break;
+					}
+				} else {
+					index_type w = left(x_parent);
+					if (isRed(w)) {
+						setBlack(w);
+						setRed(x_parent);
+						rotateRight(x_parent);
+						w = left(x_parent);
+					}
+					if ((!right(w) || !isRed(right(w))) && (!left(w) || !isRed(left(w)))) {
+						setRed(w);
+						x = x_parent;
+						x_parent = parent(x_parent);
+					} else {
+						if (!left(w) || !isRed(left(w))) {
+							setBlack(right(w));
+							setRed(w);
+							rotateLeft(w);
+							w = left(x_parent);
+						}
+						setColor(w, isRed(x_parent));
+						setBlack(x_parent);
+						if (left(w))
+							setBlack(left(w));
+						rotateRight(x_parent);
+						break;
+					}
+				}
+			}
+			if (x)
+				setBlack(x);
+		}
+
+		// Links a new node holding `value` below p (on the left if `as_left`).
+		index_type insertAt(index_type p, bool as_left, const Value &value) {
+			index_type z = newSlot();
+			try {
+				new (_nodes[z].value()) Value(value);
+			} catch (...) {
+				releaseSlot(z);
+				throw;
+			}
+			_nodes[z].child[0] = 0;
+			_nodes[z].child[1] = 0;
+			_nodes[z].parent = p | red_bit;
+			if (!p) {
+				_root = _leftmost = _rightmost = z;
+			} else if (as_left) {
+				setLeft(p, z);
+				if (p == _leftmost)
+					_leftmost = z;
+			} else {
+				setRight(p, z);
+				if (p == _rightmost)
+					_rightmost = z;
+			}
+			insertFixup(z);
+			++_size;
+			return z;
+		}
+
+	public:
+		explicit CompactTree(const Compare &comp = Compare(), const A &alloc = A())
+			: _allocator(alloc), _comp(comp) { init(); }
+
+		CompactTree(const CompactTree &other) : _allocator(other._allocator), _comp(other._comp) {
+			init();
+			if (!other._nodes)
+				return;
+			reallocate(other._capacity);
+			index_type i = 1;
+			try {
+				for (; i < other._used; ++i) {
+					_nodes[i].child[0] = other._nodes[i].child[0];
+					_nodes[i].child[1] = other._nodes[i].child[1];
+					_nodes[i].parent = other._nodes[i].parent;
+					if (other.isLive(i))
+						new (_nodes[i].value()) Value(*other._nodes[i].value());
+				}
+			} catch (...) {
+				_used = i;
+				clear();
+				_allocator.deallocate(_nodes, _capacity);
+				throw;
+			}
+			_used = other._used;
+			_free = other._free;
+			_root = other._root;
+			_leftmost = other._leftmost;
+			_rightmost = other._rightmost;
+			_size = other._size;
+		}
+
+		CompactTree &operator=(const CompactTree &other) {
+			if (this != &other) {
+				CompactTree tmp(other);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		~CompactTree() {
+			clear();
+			if (_nodes)
+				_allocator.deallocate(_nodes, _capacity);
+		}
+
+		allocator_type get_allocator() const { return allocator_type(_allocator); }
+		key_compare key_comp() const { return _comp; }
+
+		size_type size() const { return _size; }
+		size_type capacity() const { return _capacity ? _capacity - 1 : 0; }
+		size_type max_size() const { return std::min<size_type>(max_slots - 1, _allocator.max_size()); }
+		size_type memory_usage() const { return sizeof(*this) + size_type(_capacity) * sizeof(node_type); }
+
+		// Makes room for `count` elements without further reallocation.
+		void reserve(size_type count) {
+			if (count > max_size())
+				throw std::length_error("CompactTree");
+			if (count + 1 > _capacity)
+				reallocate((index_type)(count + 1));
+		}
+
+		index_type root() const { return _root; }
+		index_type first() const { return _leftmost; }
+		value_type &value(index_type i) { return *_nodes[i].value(); }
+		const value_type &value(index_type i) const { return *_nodes[i].value(); }
+
+		// In-order neighbours; 0 stands for end() in both directions.
+		index_type next(index_type i) const {
+			if (right(i))
+				return minimum(right(i));
+			index_type p = parent(i);
+			while (p && i == right(p)) {
+				i = p;
+				p = parent(p);
+			}
+			return p;
+		}
+
+		index_type prev(index_type i) const {
+			if (!i)
+				return _rightmost;
+			if (left(i))
+				return maximum(left(i));
+			index_type p = parent(i);
+			while (p && i == left(p)) {
+				i = p;
+				p = parent(p);
+			}
+			return p;
+		}
+
+		// The descents index the child array with the comparison result instead of
+		// branching on it, which random lookups would mispredict at every level.
+		index_type lower_bound(const Key &k) const {
+			index_type x = _root, y = 0;
+			while (x) {
+				bool go_right = _comp(key(x), k);
+				y = go_right ? y : x;
+				x = _nodes[x].child[go_right];
+			}
+			return y;
+		}
+
+		index_type upper_bound(const Key &k) const {
+			index_type x = _root, y = 0;
+			while (x) {
+				bool go_left = _comp(k, key(x));
+				y = go_left ? x : y;
+				x = _nodes[x].child[!go_left];
+			}
+			return y;
+		}
+
+		// Stops at the first equal key; the deepest levels are the likeliest cache misses.
+		index_type find(const Key &k) const {
+			index_type x = _root;
+			while (x) {
+				bool go_right = _comp(key(x), k);
+				if (!go_right && !_comp(k, key(x)))
+					return x;
+				x = _nodes[x].child[go_right];
+			}
+			return 0;
+		}
+
+		ft::pair<index_type, bool> insert_unique(const Value &value) {
+			const Key &k = KeyOfValue()(value);
+			index_type x = _root, p = 0;
+			bool as_left = true;
+			while (x) {
+				p = x;
+				as_left = _comp(k, key(x));
+				x = _nodes[x].child[!as_left];
+			}
+			index_type j = p;
+			if (as_left) {
+				if (p == _leftmost)
+					return ft::make_pair(insertAt(p, true, value), true);
+				j = prev(p);
+			}
+			if (_comp(key(j), k))
+				return ft::make_pair(insertAt(p, as_left, value), true);
+			return ft::make_pair(j, false);
+		}
+
+		// O(1) amortised when `value` belongs right before `hint`.
+		index_type insert_unique(index_type hint, const Value &value) {
+			const Key &k = KeyOfValue()(value);
+			if (!hint) {
+				if (_size && _comp(key(_rightmost), k))
+					return insertAt(_rightmost, false, value);
+				return insert_unique(value).first;
+			}
+			if (_comp(k, key(hint))) {
+				if (hint == _leftmost)
+					return insertAt(hint, true, value);
+				index_type before = prev(hint);
+				if (!_comp(key(before), k))
+					return insert_unique(value).first;
+				return right(before) ? insertAt(hint, true, value) : insertAt(before, false, value);
+			}
+			if (_comp(key(hint), k)) {
+				if (hint == _rightmost)
+					return insertAt(hint, false, value);
+				index_type after = next(hint);
+				if (!_comp(k, key(after)))
+					return insert_unique(value).first;
+				return right(hint) ? insertAt(after, true, value) : insertAt(hint, false, value);
+			}
+			return hint;
+		}
+
+		// Unlinks and destroys node z; no other node moves.
+		void erase(index_type z) {
+			index_type y = z, x, x_parent;
+			if (!left(z))
+				x = right(z);
+			else if (!right(z))
+				x = left(z);
+			else {
+				y = minimum(right(z));
+				x = right(y);
+			}
+			if (y != z) {
+				setParent(left(z), y);
+				setLeft(y, left(z));
+				if (y != right(z)) {
+					x_parent = parent(y);
+					if (x)
+						setParent(x, parent(y));
+					setLeft(parent(y), x);
+					setRight(y, right(z));
+					setParent(right(z), y);
+				} else
+					x_parent = y;
+				replaceChild(parent(z), z, y);
+				setParent(y, parent(z));
+				bool red = isRed(y);
+				setColor(y, isRed(z));
+				setColor(z, red);
+			} else {
+				x_parent = parent(z);
+				if (x)
+					setParent(x, parent(z));
+				replaceChild(parent(z), z, x);
+				if (_leftmost == z)
+					_leftmost = right(z) ? minimum(x) : parent(z);
+				if (_rightmost == z)
+					_rightmost = left(z) ? maximum(x) : parent(z);
+			}
+			if (!isRed(z))
+				eraseFixup(x, x_parent);
+			_nodes[z].value()->~Value();
+			releaseSlot(z);
+			if (!--_size)
+				clear();
+		}
+
+		// Destroys every element but keeps the node array for reuse.
+		void clear() {
+			if (!_nodes)
+				return;
+			destroyValues();
+			_used = 1;
+			_free = 0;
+			_root = _leftmost = _rightmost = 0;
+			_size = 0;
+		}
+
+		void swap(CompactTree &other) {
+			std::swap(_nodes, other._nodes);
+			std::swap(_capacity, other._capacity);
+			std::swap(_used, other._used);
+			std::swap(_free, other._free);
+			std::swap(_root, other._root);
+			std::swap(_leftmost, other._leftmost);
+			std::swap(_rightmost, other._rightmost);
+			std::swap(_size, other._size);
+			std::swap(_allocator, other._allocator);
+			std::swap(_comp, other._comp);
+		}
+	};
+
+	// Map over a CompactTree: about 12 bytes of link overhead per element instead
+	// of Node_'s 48 plus a separate value allocation. Holds up to 2^31 - 2 elements.
+	template < class Key, class T, class Compare = std::less<Key>, class A = std::allocator< std::pair<const Key, T> > >
+	class CompactMap {
+	public:
+		typedef Key															key_type;
+		typedef T															mapped_type;
+		typedef ft::pair<const Key, T>										value_type;
+		typedef std::size_t													size_type;
+		typedef std::ptrdiff_t												difference_type;
+		typedef Compare														key_compare;
+		typedef A															allocator_type;
+		typedef value_type&													reference;
+		typedef const value_type&											const_reference;
+		typedef ft::CompactTree<value_type, Key, ft::select_first<value_type>, Compare, A>	tree_type;
+		typedef ft::compact_tree_iterator<tree_type, value_type>			iterator;
+		typedef ft::compact_tree_iterator<const tree_type, const value_type>	const_iterator;
+		typedef ft::reverse_iterator<iterator>								reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
+
+		class value_compare {
+		friend class CompactMap;
+		public:
+			typedef bool		result_type;
+			typedef value_type	first_argument_type;
+			typedef value_type	second_argument_type;
+		protected:
+			key_compare comp;
+
+			value_compare(key_compare c) : comp(c) {}
+		public:
+			bool operator()(const value_type &x, const value_type &y) const { return comp(x.first, y.first); }
+		};
+
+	private:
+		tree_type	_tree;
+
+	public:
+		CompactMap() {}
+		explicit CompactMap(const Compare &comp, const A &alloc = A()) : _tree(comp, alloc) {}
+
+		template <class InputIt>
+		CompactMap(InputIt first, InputIt last, const Compare &comp = Compare(), const A &alloc = A())
+			: _tree(comp, alloc) { insert(first, last); }
+
+		CompactMap(const CompactMap &other) : _tree(other._tree) {}
+
+		CompactMap &operator=(const CompactMap &other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		~CompactMap() {}
+
+		allocator_type get_allocator() const { return _tree.get_allocator(); }
+
+		T &at(const Key &key) {
+			uint32_t i = _tree.find(key);
+			if (!i)
+				throw std::out_of_range("key not found");
+			return _tree.value(i).second;
+		}
+
+		const T &at(const Key &key) const {
+			uint32_t i = _tree.find(key);
+			if (!i)
+				throw std::out_of_range("key not found");
+			return _tree.value(i).second;
+		}
+
+		T &operator[](const Key &key) { return insert(ft::make_pair(key, T())).first->second; }
+
+		iterator begin() { return iterator(&_tree, _tree.first()); }
+		const_iterator begin() const { return const_iterator(&_tree, _tree.first()); }
+		iterator end() { return iterator(&_tree, 0); }
+		const_iterator end() const { return const_iterator(&_tree, 0); }
+		reverse_iterator rbegin() { return reverse_iterator(--end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(--end()); }
+		reverse_iterator rend() { return reverse_iterator(end()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(end()); }
+
+		bool empty() const { return _tree.size() == 0; }
+		size_type size() const { return _tree.size(); }
+		size_type max_size() const { return _tree.max_size(); }
+		size_type capacity() const { return _tree.capacity(); }
+		void reserve(size_type count) { _tree.reserve(count); }
+		size_type memory_usage() const { return sizeof(*this) - sizeof(tree_type) + _tree.memory_usage(); }
+
+		void clear() { _tree.clear(); }
+
+		ft::pair<iterator, bool> insert(const value_type &value) {
+			ft::pair<uint32_t, bool> res = _tree.insert_unique(value);
+			return ft::make_pair(iterator(&_tree, res.first), res.second);
+		}
+
+		iterator insert(iterator hint, const value_type &value)
+			{ return iterator(&_tree, _tree.insert_unique(hint.index(), value)); }
+
+		template <class InputIt>
+		void insert(InputIt first, InputIt last) {
+			for (; first != last; ++first)
+				_tree.insert_unique(0, value_type(first->first, first->second));
+		}
+
+		void erase(iterator pos) { _tree.erase(pos.index()); }
+
+		void erase(iterator first, iterator last) {
+			while (first != last)
+				erase(first++);
+		}
+
+		size_type erase(const Key &key) {
+			uint32_t i = _tree.find(key);
+			if (!i)
+				return 0;
+			_tree.erase(i);
+			return 1;
+		}
+
+		void swap(CompactMap &other) { _tree.swap(other._tree); }
+
+		size_type count(const Key &key) const { return _tree.find(key) ? 1 : 0; }
+		iterator find(const Key &key) { return iterator(&_tree, _tree.find(key)); }
+		const_iterator find(const Key &key) const { return const_iterator(&_tree, _tree.find(key)); }
+		iterator lower_bound(const Key &key) { return iterator(&_tree, _tree.lower_bound(key)); }
+		const_iterator lower_bound(const Key &key) const { return const_iterator(&_tree, _tree.lower_bound(key)); }
+		iterator upper_bound(const Key &key) { return iterator(&_tree, _tree.upper_bound(key)); }
+		const_iterator upper_bound(const Key &key) const { return const_iterator(&_tree, _tree.upper_bound(key)); }
+		ft::pair<iterator, iterator> equal_range(const Key &key)
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+		ft::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+
+		key_compare key_comp() const { return _tree.key_comp(); }
+		value_compare value_comp() const { return value_compare(_tree.key_comp()); }
+
+		friend bool operator==(const CompactMap &lhs, const CompactMap &rhs)
+			{ return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+		friend bool operator!=(const CompactMap &lhs, const CompactMap &rhs) { return !(lhs == rhs); }
+		friend bool operator<(const CompactMap &lhs, const CompactMap &rhs)
+			{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+		friend bool operator>(const CompactMap &lhs, const CompactMap &rhs) { return rhs < lhs; }
+		friend bool operator<=(const CompactMap &lhs, const CompactMap &rhs) { return !(rhs < lhs); }
+		friend bool operator>=(const CompactMap &lhs, const CompactMap &rhs) { return !(lhs < rhs); }
+	};
+
+	// Set over a CompactTree; elements are immutable, so both iterators are const.
+	template < class Key, class Compare = std::less<Key>, class A = std::allocator<Key> >
+	class CompactSet {
+	public:
+		typedef Key															key_type;
+		typedef Key															value_type;
+		typedef std::size_t													size_type;
+		typedef std::ptrdiff_t												difference_type;
+		typedef Compare														key_compare;
+		typedef Compare														value_compare;
+		typedef A															allocator_type;
+		typedef value_type&													reference;
+		typedef const value_type&											const_reference;
+		typedef ft::CompactTree<Key, Key, ft::identity<Key>, Compare, A>	tree_type;
+		typedef ft::compact_tree_iterator<const tree_type, const Key>		iterator;
+		typedef iterator													const_iterator;
+		typedef ft::reverse_iterator<iterator>								reverse_iterator;
+		typedef reverse_iterator											const_reverse_iterator;
+
+	private:
+		tree_type	_tree;
+
+	public:
+		CompactSet() {}
+		explicit CompactSet(const Compare &comp, const A &alloc = A()) : _tree(comp, alloc) {}
+
+		template <class InputIt>
+		CompactSet(InputIt first, InputIt last, const Compare &comp = Compare(), const A &alloc = A())
+			: _tree(comp, alloc) { insert(first, last); }
+
+		CompactSet(const CompactSet &other) : _tree(other._tree) {}
+
+		CompactSet &operator=(const CompactSet &other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		~CompactSet() {}
+
+		allocator_type get_allocator() const { return _tree.get_allocator(); }
+
+		iterator begin() const { return iterator(&_tree, _tree.first()); }
+		iterator end() const { return iterator(&_tree, 0); }
+		reverse_iterator rbegin() const { return reverse_iterator(--end()); }
+		reverse_iterator rend() const { return reverse_iterator(end()); }
+
+		bool empty() const { return _tree.size() == 0; }
+		size_type size() const { return _tree.size(); }
+		size_type max_size() const { return _tree.max_size(); }
+		size_type capacity() const { return _tree.capacity(); }
+		void reserve(size_type count) { _tree.reserve(count); }
+		size_type memory_usage() const { return sizeof(*this) - sizeof(tree_type) + _tree.memory_usage(); }
+
+		void clear() { _tree.clear(); }
+
+		ft::pair<iterator, bool> insert(const value_type &value) {
+			ft::pair<uint32_t, bool> res = _tree.insert_unique(value);
+			return ft::make_pair(iterator(&_tree, res.first), res.second);
+		}
+
+		iterator insert(iterator hint, const value_type &value)
+			{ return iterator(&_tree, _tree.insert_unique(hint.index(), value)); }
+
+		template <class InputIt>
+		void insert(InputIt first, InputIt last) {
+			for (; first != last; ++first)
+				_tree.insert_unique(0, *first);
+		}
+
+		void erase(iterator pos) { _tree.erase(pos.index()); }
+
+		void erase(iterator first, iterator last) {
+			while (first != last)
+				erase(first++);
+		}
+
+		size_type erase(const Key &key) {
+			uint32_t i = _tree.find(key);
+			if (!i)
+				return 0;
+			_tree.erase(i);
+			return 1;
+		}
+
+		void swap(CompactSet &other) { _tree.swap(other._tree); }
+
+		size_type count(const Key &key) const { return _tree.find(key) ? 1 : 0; }
+		iterator find(const Key &key) const { return iterator(&_tree, _tree.find(key)); }
+		iterator lower_bound(const Key &key) const { return iterator(&_tree, _tree.lower_bound(key)); }
+		iterator upper_bound(const Key &key) const { return iterator(&_tree, _tree.upper_bound(key)); }
+		ft::pair<iterator, iterator> equal_range(const Key &key) const
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+
+		key_compare key_comp() const { return _tree.key_comp(); }
+		value_compare value_comp() const { return _tree.key_comp(); }
+
+		friend bool operator==(const CompactSet &lhs, const CompactSet &rhs)
+			{ return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+		friend bool operator!=(const CompactSet &lhs, const CompactSet &rhs) { return !(lhs == rhs); }
+		friend bool operator<(const CompactSet &lhs, const CompactSet &rhs)
+			{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+		friend bool operator>(const CompactSet &lhs, const CompactSet &rhs) { return rhs < lhs; }
+		friend bool operator<=(const CompactSet &lhs, const CompactSet &rhs) { return !(rhs < lhs); }
+		friend bool operator>=(const CompactSet &lhs, const CompactSet &rhs) { return !(lhs < rhs); }
+	};
+}
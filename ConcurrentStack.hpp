@@ -0,0 +1,169 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <stdint.h>
+
+#include "Utility.hpp"
+
+namespace ft {
+	// Lock-free LIFO (Treiber stack) shared between threads. The list heads are
+	// tagged pointers: the low 48 bits hold the node address and the high 16 bits a
+	// counter bumped on every successful update, so a head that was popped and
+	// pushed back between a load and its CAS no longer compares equal (ABA).
+	// Popped nodes go to a lock-free free-list instead of the allocator; nodes stay
+	// valid memory until the stack is destroyed, so a racing reader that follows a
+	// stale next pointer never touches freed storage.
+	template < class T, class A = std::allocator<T> >
+	class ConcurrentStack {
+	public:
+		typedef T				value_type;
+		typedef A				allocator_type;
+		typedef std::size_t		size_type;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+
+	private:
+		struct Node {
+			Node	*next;
+			char	value[sizeof(T)] __attribute__((aligned(__alignof__(T))));
+
+			T *ptr() { return reinterpret_cast<T *>(value); }
+		};
+
+		typedef typename A::template rebind<Node>::other	allocator_rebind_node;
+
+		static const uint64_t	pointer_mask = (uint64_t(1) << 48) - 1;
+
+		allocator_type			_allocator;
+		allocator_rebind_node	_allocator_rebind_node;
+		uint64_t				_head __attribute__((aligned(64)));
+		uint64_t				_free __attribute__((aligned(64)));
+
+		ConcurrentStack(const ConcurrentStack &);
+		ConcurrentStack &operator=(const ConcurrentStack &);
+
+		static Node *pointer(uint64_t tagged) { return reinterpret_cast<Node *>(uintptr_t(tagged & pointer_mask)); }
+		static uint64_t tag(Node *node, uint64_t old)
+			{ return (uint64_t(reinterpret_cast<uintptr_t>(node)) & pointer_mask) | ((old & ~pointer_mask) + (pointer_mask + 1)); }
+
+		static void pushNode(uint64_t *head, Node *node) {
+			uint64_t old = __atomic_load_n(head, __ATOMIC_RELAXED);
+			do {
+				__atomic_store_n(&node->next, pointer(old), __ATOMIC_RELAXED);
+			} while (!__atomic_compare_exchange_n(head, &old, tag(node, old), true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+		}
+
+		static Node *popNode(uint64_t *head) {
+			uint64_t old = __atomic_load_n(head, __ATOMIC_ACQUIRE);
+			Node *node;
+			do {
+				node = pointer(old);
+				if (!node)
+					return 0;
+			} while (!__atomic_compare_exchange_n(head, &old, tag(__atomic_load_n(&node->next, __ATOMIC_RELAXED), old),
+												  true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+			return node;
+		}
+
+		Node *acquireNode() {
+			Node *node = popNode(&_free);
+			if (!node)
+				node = ft::node_storage_traits<allocator_rebind_node>::allocate(_allocator_rebind_node);
+			return node;
+		}
+
+		static void releaseNodes(allocator_rebind_node &alloc, Node *node, bool destroy_values) {
+			while (node) {
+				Node *next = node->next;
+				if (destroy_values)
+					node->ptr()->~T();
+				ft::node_storage_traits<allocator_rebind_node>::deallocate(alloc, node);
+				node = next;
+			}
+		}
+
+	public:
+		explicit ConcurrentStack(const A& alloc = A())
+			: _allocator(alloc), _allocator_rebind_node(alloc), _head(0), _free(0) {}
+
+		~ConcurrentStack() {
+			releaseNodes(_allocator_rebind_node, pointer(_head), true);
+			releaseNodes(_allocator_rebind_node, pointer(_free), false);
+		}
+
+		// Pre-allocates free nodes so that the next `count` pushes do not allocate.
+		void reserve(size_type count) {
+			for (; count; --count)
+				pushNode(&_free, ft::node_storage_traits<allocator_rebind_node>::allocate(_allocator_rebind_node));
+		}
+
+		void push(const value_type &value) {
+			Node *node = acquireNode();
+			try {
+				new (node->ptr()) T(value);
+			} catch (...) {
+				pushNode(&_free, node);
+				throw;
+			}
+			pushNode(&_head, node);
+		}
+
+#if __cplusplus >= 201103L
+		void push(value_type &&value) { emplace(std::move(value)); }
+
+		template <class... Args>
+		void emplace(Args&&... args) {
+			Node *node = acquireNode();
+			try {
+				new (node->ptr()) T(std::forward<Args>(args)...);
+			} catch (...) {
+				pushNode(&_free, node);
+				throw;
+			}
+			pushNode(&_head, node);
+		}
+#endif
+
+		// Moves the top element into `out`. Returns false if the stack was empty.
+		// The element is copied instead when its move may throw; if that throws,
+		// it goes back on the stack untouched (other threads may have pushed
+		// above it meanwhile) and the exception propagates.
+		bool pop(value_type &out) {
+			Node *node = popNode(&_head);
+			if (!node)
+				return false;
+			try {
+				out = FT_MOVE_IF_NOEXCEPT(*node->ptr());
+			} catch (...) {
+				pushNode(&_head, node);
+				throw;
+			}
+			node->ptr()->~T();
+			pushNode(&_free, node);
+			return true;
+		}
+
+		// Copies the top element into `out` without removing it. The copy is
+		// retried until the head did not change while it was taken, so the result
+		// is a consistent snapshot; only trivially copyable types can be read this way.
+		bool top(value_type &out) const {
+			typedef char top_requires_trivially_copyable[ft::is_trivially_copyable<T>::value ? 1 : -1];
+			(void)sizeof(top_requires_trivially_copyable);
+			uint64_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+			for (;;) {
+				Node *node = pointer(head);
+				if (!node)
+					return false;
+				__builtin_memcpy(static_cast<void *>(&out), node->value, sizeof(T));
+				__atomic_thread_fence(__ATOMIC_ACQUIRE);
+				uint64_t again = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+				if (again == head)
+					return true;
+				head = again;
+			}
+		}
+
+		bool empty() const { return pointer(__atomic_load_n(&_head, __ATOMIC_ACQUIRE)) == 0; }
+	};
+}
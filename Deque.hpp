@@ -0,0 +1,467 @@
+#pragma once
+
+#include "Iterator.hpp"
+
+namespace ft {
+	template <class T, class Ref, class Ptr>
+	class deque_iterator {
+	public:
+		typedef std::random_access_iterator_tag	iterator_category;
+		typedef T								value_type;
+		typedef std::ptrdiff_t					difference_type;
+		typedef Ptr								pointer;
+		typedef const T*						const_pointer;
+		typedef Ref								reference;
+		typedef const T&						const_reference;
+
+		static difference_type chunk_size()
+			{ return sizeof(T) <= 256 ? 4096 / sizeof(T) : 16; }
+
+		T	*cur;
+		T	*first;
+		T	*last;
+		T	**node;
+
+		deque_iterator() : cur(0), first(0), last(0), node(0) {}
+		deque_iterator(T *x, T **n) : cur(x), first(*n), last(*n + chunk_size()), node(n) {}
+		template <class R, class P>
+		deque_iterator(const deque_iterator<T, R, P> &other)
+			: cur(other.cur), first(other.first), last(other.last), node(other.node) {}
+
+		void set_node(T **n) {
+			node = n;
+			first = *n;
+			last = first + chunk_size();
+		}
+
+		reference operator*() const { return *cur; }
+		pointer operator->() const { return cur; }
+
+		deque_iterator &operator++() {
+			if (++cur == last) {
+				set_node(node + 1);
+				cur = first;
+			}
+			return *this;
+		}
+		deque_iterator operator++(int) { deque_iterator tmp(*this); ++*this; return tmp; }
+
+		deque_iterator &operator--() {
+			if (cur == first) {
+				set_node(node - 1);
+				cur = last;
+			}
+			--cur;
+			return *this;
+		}
+		deque_iterator operator--(int) { deque_iterator tmp(*this); --*this; return tmp; }
+
+		deque_iterator &operator+=(difference_type n) {
+			difference_type offset = n + (cur - first);
+			if (offset >= 0 && offset < chunk_size())
+				cur += n;
+			else {
+				difference_type node_offset = offset > 0 ? offset / chunk_size()
+														 : -((-offset - 1) / chunk_size()) - 1;
+				set_node(node + node_offset);
+				cur = first + (offset - node_offset * chunk_size());
+			}
+			return *this;
+		}
+		deque_iterator &operator-=(difference_type n) { return *this += -n; }
+		deque_iterator operator+(difference_type n) const { deque_iterator tmp(*this); return tmp += n; }
+		deque_iterator operator-(difference_type n) const { deque_iterator tmp(*this); return tmp -= n; }
+		friend deque_iterator operator+(difference_type n, const deque_iterator &it) { return it + n; }
+		reference operator[](difference_type n) const { return *(*this + n); }
+
+		template <class R, class P>
+		difference_type operator-(const deque_iterator<T, R, P> &other) const {
+			return chunk_size() * (node - other.node - 1) + (cur - first) + (other.last - other.cur);
+		}
+
+		template <class R, class P>
+		bool operator==(const deque_iterator<T, R, P> &other) const { return cur == other.cur; }
+		template <class R, class P>
+		bool operator!=(const deque_iterator<T, R, P> &other) const { return cur != other.cur; }
+		template <class R, class P>
+		bool operator<(const deque_iterator<T, R, P> &other) const
+			{ return node == other.node ? cur < other.cur : node < other.node; }
+		template <class R, class P>
+		bool operator>(const deque_iterator<T, R, P> &other) const { return other < *this; }
+		template <class R, class P>
+		bool operator<=(const deque_iterator<T, R, P> &other) const { return !(other < *this); }
+		template <class R, class P>
+		bool operator>=(const deque_iterator<T, R, P> &other) const { return !(*this < other); }
+	};
+
+	// Elements live in fixed-size chunks reached through a map of chunk pointers.
+	// Growth at either end only allocates a chunk or re-centres the map, so
+	// references stay valid and no element is ever copied.
+	template < class T, class A = std::allocator<T> >
+class Deque {
+public:
+	typedef T													value_type;
+	typedef A													allocator_type;
+	typedef std::size_t											size_type;
+	typedef std::ptrdiff_t										difference_type;
+	typedef value_type&											reference;
+	typedef const value_type&									const_reference;
+	typedef T*													pointer;
+	typedef const T*											const_pointer;
+	typedef ft::deque_iterator<T, T&, T*>						iterator;
+	typedef ft::deque_iterator<T, const T&, const T*>			const_iterator;
+	typedef ft::reverse_iterator<iterator>						reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>				const_reverse_iterator;
+	typedef typename allocator_type::template rebind<T*>::other	allocator_rebind_map;
+private:
+	allocator_type			_allocator;
+	allocator_rebind_map	_allocator_rebind_map;
+	T						**_map;
+	size_type				_map_size;
+	iterator				_start;
+	iterator				_finish;
+
+	static size_type chunk_size() { return iterator::chunk_size(); }
+
+	void initialize() {
+		_map_size = 8;
+		_map = _allocator_rebind_map.allocate(_map_size);
+		std::fill(_map, _map + _map_size, (T*)0);
+		T **node = _map + _map_size / 2;
+		try {
+			*node = _allocator.allocate(chunk_size());
+		} catch (...) {
+			_allocator_rebind_map.deallocate(_map, _map_size);
+			throw;
+		}
+		_start = iterator(*node + chunk_size() / 2, node);
+		_finish = _start;
+	}
+
+	// Destroys the elements and frees every chunk and the map. Used by the
+	// destructor and by constructors that fail after initialize().
+	void release() {
+		clear();
+		_allocator.deallocate(*_start.node, chunk_size());
+		_allocator_rebind_map.deallocate(_map, _map_size);
+	}
+
+	void reallocateMap(size_type nodes_to_add, bool at_front) {
+		size_type old_nodes = _finish.node - _start.node + 1;
+		size_type new_nodes = old_nodes + nodes_to_add;
+		T **new_start;
+
+		if (_map_size > 2 * new_nodes + 2) {
+			new_start = _map + (_map_size - new_nodes) / 2 + (at_front ? nodes_to_add : 0);
+			if (new_start < _start.node)
+				std::copy(_start.node, _finish.node + 1, new_start);
+			else
+				std::copy_backward(_start.node, _finish.node + 1, new_start + old_nodes);
+			T **lo = std::min(new_start, _start.node);
+			T **hi = std::max(new_start + old_nodes, _finish.node + 1);
+			for (T **p = lo; p != hi; ++p)
+				if (p < new_start || p >= new_start + old_nodes)
+					*p = 0;
+		} else {
+			size_type new_map_size = _map_size + std::max(_map_size, nodes_to_add) + 2;
+			T **new_map = _allocator_rebind_map.allocate(new_map_size);
+			std::fill(new_map, new_map + new_map_size, (T*)0);
+			new_start = new_map + (new_map_size - new_nodes) / 2 + (at_front ? nodes_to_add : 0);
+			std::copy(_start.node, _finish.node + 1, new_start);
+			_allocator_rebind_map.deallocate(_map, _map_size);
+			_map = new_map;
+			_map_size = new_map_size;
+		}
+		_start.set_node(new_start);
+		_finish.set_node(new_start + old_nodes - 1);
+	}
+
+	void reserveMapAtBack() {
+		if (2 > _map_size - (_finish.node - _map) - 1)
+			reallocateMap(1, false);
+	}
+
+	void reserveMapAtFront() {
+		if (2 > (size_type)(_start.node - _map))
+			reallocateMap(1, true);
+	}
+
+	// The slot after the last element; the next chunk is allocated up front when
+	// this is the final slot of a chunk so that _finish stays dereferenceable.
+	T *backSlot() {
+		if (_finish.cur == _finish.last - 1) {
+			reserveMapAtBack();
+			*(_finish.node + 1) = _allocator.allocate(chunk_size());
+		}
+		return _finish.cur;
+	}
+
+	void releaseBackSlot() {
+		if (_finish.cur == _finish.last - 1) {
+			_allocator.deallocate(*(_finish.node + 1), chunk_size());
+			*(_finish.node + 1) = 0;
+		}
+	}
+
+	void commitBackSlot() {
+		if (_finish.cur != _finish.last - 1)
+			++_finish.cur;
+		else {
+			_finish.set_node(_finish.node + 1);
+			_finish.cur = _finish.first;
+		}
+	}
+
+	T *frontSlot() {
+		if (_start.cur != _start.first)
+			return _start.cur - 1;
+		reserveMapAtFront();
+		*(_start.node - 1) = _allocator.allocate(chunk_size());
+		return *(_start.node - 1) + chunk_size() - 1;
+	}
+
+	void releaseFrontSlot() {
+		if (_start.cur == _start.first) {
+			_allocator.deallocate(*(_start.node - 1), chunk_size());
+			*(_start.node - 1) = 0;
+		}
+	}
+
+	void commitFrontSlot() {
+		if (_start.cur == _start.first) {
+			_start.set_node(_start.node - 1);
+			_start.cur = _start.last;
+		}
+		--_start.cur;
+	}
+
+public:
+	explicit Deque(const A& alloc = A()) : _allocator(alloc), _allocator_rebind_map(alloc) {
+		initialize();
+	}
+
+	Deque(size_type count, const_reference value = value_type(), const A& alloc = A())
+		: _allocator(alloc), _allocator_rebind_map(alloc) {
+		initialize();
+		try {
+			assign(count, value);
+		} catch (...) {
+			release();
+			throw;
+		}
+	}
+
+	template <class InputIterator>
+	Deque(InputIterator first, InputIterator last, const A& alloc = A(),
+		  typename ft::enable_if<!ft::is_integral<InputIterator>::value, void>::type* = 0)
+		: _allocator(alloc), _allocator_rebind_map(alloc) {
+		initialize();
+		try {
+			assign(first, last);
+		} catch (...) {
+			release();
+			throw;
+		}
+	}
+
+	Deque(const Deque& other)
+		: _allocator(other._allocator), _allocator_rebind_map(other._allocator_rebind_map) {
+		initialize();
+		try {
+			assign(other.begin(), other.end());
+		} catch (...) {
+			release();
+			throw;
+		}
+	}
+
+#if __cplusplus >= 201103L
+	Deque(Deque&& other) : _allocator(other._allocator), _allocator_rebind_map(other._allocator_rebind_map) {
+		initialize();
+		this->swap(other);
+	}
+
+	Deque& operator=(Deque&& other) noexcept {
+		this->swap(other);
+		return *this;
+	}
+#endif
+
+	~Deque() {
+		release();
+	}
+
+	Deque& operator=(const Deque& other) {
+		if (this != &other)
+			assign(other.begin(), other.end());
+		return *this;
+	}
+
+	void assign(size_type count, const_reference value) {
+		value_type copy(value);
+		clear();
+		for (; count; --count)
+			push_back(copy);
+	}
+
+	template <class InputIterator>
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value, void>::type
+	assign(InputIterator first, InputIterator last) {
+		clear();
+		for (; first != last; ++first)
+			push_back(*first);
+	}
+
+	allocator_type get_allocator() const { return _allocator; }
+
+	reference at(size_type pos) {
+		if (pos >= size())
+			throw std::out_of_range("Deque");
+		return _start[pos];
+	}
+
+	const_reference at(size_type pos) const {
+		if (pos >= size())
+			throw std::out_of_range("Deque");
+		return _start[pos];
+	}
+
+	reference operator[](size_type pos) { return _start[pos]; }
+	const_reference operator[](size_type pos) const { return _start[pos]; }
+	reference front() { return *_start; }
+	const_reference front() const { return *_start; }
+	reference back() { return *(_finish - 1); }
+	const_reference back() const { return *(_finish - 1); }
+	iterator begin() { return _start; }
+	const_iterator begin() const { return _start; }
+	iterator end() { return _finish; }
+	const_iterator end() const { return _finish; }
+	reverse_iterator rbegin() { return reverse_iterator(_finish - 1); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(const_iterator(_finish - 1)); }
+	reverse_iterator rend() { return reverse_iterator(_start - 1); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(const_iterator(_start - 1)); }
+	bool empty() const { return _start == _finish; }
+	size_type size() const { return _finish - _start; }
+	size_type max_size() const { return _allocator.max_size(); }
+	// The deque, its map and every chunk between the first and last element.
+	size_type memory_usage() const {
+		return sizeof(*this) + _map_size * sizeof(T*) + (_finish.node - _start.node + 1) * chunk_size() * sizeof(T);
+	}
+
+	void clear() {
+		for (iterator it = _start; it != _finish; ++it)
+			_allocator.destroy(it.cur);
+		for (T **node = _start.node + 1; node <= _finish.node; ++node) {
+			_allocator.deallocate(*node, chunk_size());
+			*node = 0;
+		}
+		_start.cur = _start.first + chunk_size() / 2;
+		_finish = _start;
+	}
+
+	void push_back(const_reference value) {
+		T *slot = backSlot();
+		try {
+			_allocator.construct(slot, value);
+		} catch (...) {
+			releaseBackSlot();
+			throw;
+		}
+		commitBackSlot();
+	}
+
+	void push_front(const_reference value) {
+		T *slot = frontSlot();
+		try {
+			_allocator.construct(slot, value);
+		} catch (...) {
+			releaseFrontSlot();
+			throw;
+		}
+		commitFrontSlot();
+	}
+
+#if __cplusplus >= 201103L
+	void push_back(value_type&& value) { emplace_back(std::move(value)); }
+	void push_front(value_type&& value) { emplace_front(std::move(value)); }
+
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		T *slot = backSlot();
+		try {
+			std::allocator_traits<A>::construct(_allocator, slot, std::forward<Args>(args)...);
+		} catch (...) {
+			releaseBackSlot();
+			throw;
+		}
+		commitBackSlot();
+		return *slot;
+	}
+
+	template <class... Args>
+	reference emplace_front(Args&&... args) {
+		T *slot = frontSlot();
+		try {
+			std::allocator_traits<A>::construct(_allocator, slot, std::forward<Args>(args)...);
+		} catch (...) {
+			releaseFrontSlot();
+			throw;
+		}
+		commitFrontSlot();
+		return *slot;
+	}
+#endif
+
+	void pop_back() {
+		if (_finish.cur != _finish.first) {
+			--_finish.cur;
+			_allocator.destroy(_finish.cur);
+			return;
+		}
+		_allocator.deallocate(_finish.first, chunk_size());
+		*_finish.node = 0;
+		_finish.set_node(_finish.node - 1);
+		_finish.cur = _finish.last - 1;
+		_allocator.destroy(_finish.cur);
+	}
+
+	void pop_front() {
+		_allocator.destroy(_start.cur);
+		if (_start.cur != _start.last - 1) {
+			++_start.cur;
+			return;
+		}
+		_allocator.deallocate(_start.first, chunk_size());
+		*_start.node = 0;
+		_start.set_node(_start.node + 1);
+		_start.cur = _start.first;
+	}
+
+	void resize(size_type count, T value = T()) {
+		while (size() > count)
+			pop_back();
+		while (size() < count)
+			push_back(value);
+	}
+
+	void swap(Deque& other) {
+		std::swap(_allocator, other._allocator);
+		std::swap(_allocator_rebind_map, other._allocator_rebind_map);
+		std::swap(_map, other._map);
+		std::swap(_map_size, other._map_size);
+		std::swap(_start, other._start);
+		std::swap(_finish, other._finish);
+	}
+
+	friend bool operator==(const Deque &lhs, const Deque &rhs) {
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+	friend bool operator!=(const Deque &lhs, const Deque &rhs) { return !(lhs == rhs); }
+	friend bool operator<(const Deque &lhs, const Deque &rhs) {
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+	friend bool operator>(const Deque &lhs, const Deque &rhs) { return rhs < lhs; }
+	friend bool operator<=(const Deque &lhs, const Deque &rhs) { return !(rhs < lhs); }
+	friend bool operator>=(const Deque &lhs, const Deque &rhs) { return !(lhs < rhs); }
+};
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+
+namespace ft {
+	struct file_storage_header {
+		char		magic[8];
+		uint32_t	version;
+		uint32_t	value_size;
+		uint64_t	size;
+		char		reserved[40];
+	};
+
+	static const char	file_storage_magic[8] = { 'F', 'T', 'V', 'E', 'C', 0, 0, 0 };
+
+	// Backs a single Vector buffer with a shared mapping of `path`. The file keeps a
+	// 64-byte header; ft::flush() records the element count there so a later
+	// Vector(file_allocator<T>(path)) reopens the same contents without copying.
+	template <class T>
+	class file_allocator {
+		typedef char trivially_copyable_check[ft::is_trivially_copyable<T>::value ? 1 : -1];
+
+		struct state {
+			int		fd;
+			char	*base;
+			size_t	length;
+			size_t	refs;
+		};
+
+		state	*_state;
+
+		static size_t bytes_for(size_t n)
+			{ return sizeof(file_storage_header) + n * sizeof(T); }
+
+		file_storage_header *header() const
+			{ return reinterpret_cast<file_storage_header *>(_state->base); }
+
+		void resize_file(size_t length) {
+			struct stat st;
+			if (::fstat(_state->fd, &st) != 0)
+				throw std::bad_alloc();
+			if ((size_t)st.st_size < length && ::ftruncate(_state->fd, length) != 0)
+				throw std::bad_alloc();
+		}
+
+		void map(size_t length) {
+			void *base = ::mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, _state->fd, 0);
+			if (base == MAP_FAILED)
+				throw std::bad_alloc();
+			_state->base = static_cast<char *>(base);
+			_state->length = length;
+		}
+
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		explicit file_allocator(const char *path) : _state(new state()) {
+			_state->fd = ::open(path, O_RDWR | O_CREAT, 0644);
+			_state->base = 0;
+			_state->length = 0;
+			_state->refs = 1;
+			if (_state->fd < 0) {
+				delete _state;
+				throw std::runtime_error("file_allocator: cannot open file");
+			}
+		}
+
+		file_allocator(const file_allocator &other) : _state(other._state)
+			{ ++_state->refs; }
+
+		file_allocator &operator=(const file_allocator &other) {
+			file_allocator tmp(other);
+			std::swap(_state, tmp._state);
+			return *this;
+		}
+
+		~file_allocator() {
+			if (--_state->refs)
+				return;
+			if (_state->base)
+				::munmap(_state->base, _state->length);
+			::close(_state->fd);
+			delete _state;
+		}
+
+		pointer allocate(size_type n) {
+			if (_state->base)
+				throw std::bad_alloc();
+			size_t length = bytes_for(n);
+			resize_file(length);
+			map(length);
+			std::memcpy(header()->magic, file_storage_magic, sizeof(header()->magic));
+			header()->version = 1;
+			header()->value_size = sizeof(T);
+			return reinterpret_cast<pointer>(_state->base + sizeof(file_storage_header));
+		}
+
+		void deallocate(pointer, size_type) {
+			if (!_state->base)
+				return;
+			::munmap(_state->base, _state->length);
+			_state->base = 0;
+			_state->length = 0;
+		}
+
+		bool reallocate(pointer &p, size_type, size_type n) {
+			size_t length = bytes_for(n);
+			resize_file(length);
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+			void *base = ::mremap(_state->base, _state->length, length, MREMAP_MAYMOVE);
+			if (base == MAP_FAILED)
+				throw std::bad_alloc();
+			_state->base = static_cast<char *>(base);
+			_state->length = length;
+#else
+			::munmap(_state->base, _state->length);
+			map(length);
+#endif
+			p = reinterpret_cast<pointer>(_state->base + sizeof(file_storage_header));
+			return true;
+		}
+
+		pointer restore(size_type &size, size_type &capacity) {
+			size = capacity = 0;
+			struct stat st;
+			if (_state->base || ::fstat(_state->fd, &st) != 0 || (size_t)st.st_size < sizeof(file_storage_header))
+				return 0;
+			map(st.st_size);
+			if (std::memcmp(header()->magic, file_storage_magic, sizeof(header()->magic)) != 0
+				|| header()->value_size != sizeof(T)) {
+				::munmap(_state->base, _state->length);
+				_state->base = 0;
+				throw std::runtime_error("file_allocator: incompatible file");
+			}
+			capacity = (_state->length - sizeof(file_storage_header)) / sizeof(T);
+			size = std::min<size_type>(header()->size, capacity);
+			return reinterpret_cast<pointer>(_state->base + sizeof(file_storage_header));
+		}
+
+		void sync(size_type size) {
+			if (!_state->base)
+				return;
+			header()->size = size;
+			if (::msync(_state->base, _state->length, MS_SYNC) != 0)
+				throw std::runtime_error("file_allocator: msync failed");
+		}
+
+		void construct(pointer p, const_reference value) { new (p) T(value); }
+		void destroy(pointer p) { p->~T(); }
+		size_type max_size() const { return (std::numeric_limits<size_type>::max() - sizeof(file_storage_header)) / sizeof(T); }
+
+		friend bool operator==(const file_allocator &lhs, const file_allocator &rhs) { return lhs._state == rhs._state; }
+		friend bool operator!=(const file_allocator &lhs, const file_allocator &rhs) { return lhs._state != rhs._state; }
+	};
+
+	template <class T>
+	struct storage_traits<file_allocator<T> > {
+		static bool reallocate(file_allocator<T>& a, T*& p, std::size_t old_n, std::size_t n)
+			{ return a.reallocate(p, old_n, n); }
+		static T* restore(file_allocator<T>& a, std::size_t& size, std::size_t& capacity)
+			{ return a.restore(size, capacity); }
+	};
+
+	template <class T>
+	void flush(const ft::Vector<T, file_allocator<T> >& v) {
+		v.get_allocator().sync(v.size());
+	}
+}
@@ -44,6 +44,8 @@ namespace ft {
 
 		iterator(T value = NULL)
 			: value(value){}
+		iterator(const iterator &obj)
+			: value(obj.value){}
 		~iterator(){};
 		template <class U>iterator(const iterator<U>& other,
 				typename ft::enable_if<std::is_convertible<U, iterator_type>::value>::type* = 0)
@@ -52,8 +54,8 @@ namespace ft {
 		T base() const
 		{ return value; }
 
-		reference operator[](const unsigned int index)
-			{ return *this->value[index]; }
+		reference operator[](difference_type n) const
+			{ return this->value[n]; }
 		iterator &operator=(const iterator &obj)
 			{ this->value = obj.value; return *this; }
 		iterator operator++(int)
@@ -64,18 +66,18 @@ namespace ft {
 			{ value++; return *this; }
 		iterator &operator--()
 			{ value--; return *this; }
-		int operator-(iterator const &obj) const
+		difference_type operator-(iterator const &obj) const
 			{ return value - obj.value; }
-		int operator+(iterator const &obj) const
-			{ return value + obj.value; }
-		iterator operator-(int n) const
+		iterator operator-(difference_type n) const
 			{ return iterator(this->value - n); }
-		iterator operator+(int n) const
+		iterator operator+(difference_type n) const
 			{ return iterator(this->value + n); }
-		iterator &operator-=(int n)
+		iterator &operator-=(difference_type n)
 			{ this->value -= n; return (*this); }
-		iterator &operator+=(int n)
+		iterator &operator+=(difference_type n)
 			{ this->value += n; return (*this); }
+		friend iterator operator+(difference_type n, iterator const &it)
+			{ return it + n; }
 		reference operator*() const
 			{ return *value; }
 		pointer operator->() const
@@ -131,13 +133,16 @@ namespace ft {
 				while (!node->right->NIL)
 					node = node->right;
 			} else {
+				T current = node;
 				T tmp = node;
 				node = node->parent;
-				while (node->right != tmp) {
+				while (node && node->right != tmp) {
 					tmp = node;
-					if (!node->parent) { node = tmp->left - 1; break; }
 					node = node->parent;
 				}
+				// Stepping back from the first node lands on the sentinel, i.e. rend().
+				if (!node)
+					node = current->left;
 			}
 		}
 	public:
@@ -148,10 +153,12 @@ namespace ft {
 		typedef const Pair&	const_reference;
 		typedef Pair*		pointer;
 		typedef const Pair*	const_pointer;
-		typedef typename iterator_traits<iterator_type>::iterator_category  iterator_category;
+		typedef std::bidirectional_iterator_tag	iterator_category;
 
 		node_iterator(T value = nullptr)
 			: node(value){};
+		node_iterator(const node_iterator &obj)
+			: node(obj.node){};
 		~node_iterator(){};
 		template <class U, class Z> node_iterator(const node_iterator<U, Z>& other,
 			typename ft::enable_if<std::is_convertible<U, T>::value>::type* = 0)
@@ -204,6 +211,7 @@ namespace ft {
 		typedef typename iterator_traits<T>::iterator_category	iterator_category;
 
 		reverse_iterator(iterator_type value = nullptr) : iterator(value){};
+		reverse_iterator(const reverse_iterator &obj) : iterator(obj.iterator){};
 		~reverse_iterator(){};
 		template <class U> reverse_iterator(const reverse_iterator<U>& other,
 				typename ft::enable_if<std::is_convertible<U, T>::value>::type* = 0)
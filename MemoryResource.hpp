@@ -0,0 +1,487 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <pthread.h>
+
+#include "Utility.hpp"
+
+namespace ft {
+	union max_align_type { long double ld; long long ll; double d; void *p; void (*f)(); };
+
+	// Alignment that ::operator new guarantees; stricter requests take a separate path.
+	static const std::size_t max_align = __alignof__(max_align_type);
+
+	inline std::size_t align_up(std::size_t n, std::size_t alignment)
+		{ return (n + alignment - 1) & ~(alignment - 1); }
+
+	// Source of raw memory for polymorphic_allocator. Containers built on the same
+	// resource share its memory regardless of their element or node types.
+	class memory_resource {
+	public:
+		virtual ~memory_resource() {}
+
+		void *allocate(std::size_t bytes, std::size_t alignment = max_align)
+			{ return do_allocate(bytes, alignment); }
+		void deallocate(void *p, std::size_t bytes, std::size_t alignment = max_align)
+			{ do_deallocate(p, bytes, alignment); }
+		bool is_equal(const memory_resource &other) const
+			{ return this == &other || do_is_equal(other); }
+
+	protected:
+		virtual void *do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+		virtual void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) = 0;
+		virtual bool do_is_equal(const memory_resource &other) const = 0;
+	};
+
+	inline bool operator==(const memory_resource &a, const memory_resource &b) { return a.is_equal(b); }
+	inline bool operator!=(const memory_resource &a, const memory_resource &b) { return !a.is_equal(b); }
+
+	class new_delete_memory_resource : public memory_resource {
+	protected:
+		void *do_allocate(std::size_t bytes, std::size_t alignment) {
+			if (alignment <= max_align)
+				return ::operator new(bytes);
+			void *p = 0;
+			if (::posix_memalign(&p, alignment, bytes ? bytes : 1) != 0)
+				throw std::bad_alloc();
+			return p;
+		}
+
+		void do_deallocate(void *p, std::size_t, std::size_t alignment) {
+			if (alignment <= max_align)
+				::operator delete(p);
+			else
+				std::free(p);
+		}
+
+		bool do_is_equal(const memory_resource &other) const { return this == &other; }
+	};
+
+	// Throws on every allocation; an upstream for resources that must never grow.
+	class null_memory_resource : public memory_resource {
+	protected:
+		void *do_allocate(std::size_t, std::size_t) { throw std::bad_alloc(); }
+		void do_deallocate(void *, std::size_t, std::size_t) {}
+		bool do_is_equal(const memory_resource &other) const { return this == &other; }
+	};
+
+	inline memory_resource *new_delete_resource() {
+		static new_delete_memory_resource resource;
+		return &resource;
+	}
+
+	inline memory_resource *null_resource() {
+		static null_memory_resource resource;
+		return &resource;
+	}
+
+	inline memory_resource *&default_resource_slot() {
+		static memory_resource *resource = 0;
+		return resource;
+	}
+
+	inline memory_resource *get_default_resource() {
+		memory_resource *resource = __atomic_load_n(&default_resource_slot(), __ATOMIC_ACQUIRE);
+		return resource ? resource : new_delete_resource();
+	}
+
+	// Returns the previous default; passing 0 restores new_delete_resource().
+	inline memory_resource *set_default_resource(memory_resource *resource) {
+		if (!resource)
+			resource = new_delete_resource();
+		memory_resource *old = __atomic_exchange_n(&default_resource_slot(), resource, __ATOMIC_ACQ_REL);
+		return old ? old : new_delete_resource();
+	}
+
+	// Bump allocator: deallocate is a no-op and everything is returned to the
+	// upstream at once by release() or the destructor. Each new chunk is twice
+	// the size of the previous one. Meant for request-scoped containers.
+	class monotonic_buffer_resource : public memory_resource {
+		struct chunk {
+			chunk		*next;
+			std::size_t	size;
+		};
+
+		enum { default_next_size = 1024 };
+
+		memory_resource	*_upstream;
+		void			*_initial_buffer;
+		std::size_t		_initial_size;
+		std::size_t		_initial_next_size;
+		char			*_current;
+		std::size_t		_remaining;
+		std::size_t		_next_size;
+		chunk			*_chunks;
+
+		monotonic_buffer_resource(const monotonic_buffer_resource &);
+		monotonic_buffer_resource &operator=(const monotonic_buffer_resource &);
+
+		static std::size_t header_size() { return align_up(sizeof(chunk), max_align); }
+
+		void newChunk(std::size_t min_bytes) {
+			std::size_t size = std::max(_next_size, header_size() + min_bytes);
+			chunk *c = static_cast<chunk *>(_upstream->allocate(size, max_align));
+			c->next = _chunks;
+			c->size = size;
+			_chunks = c;
+			_current = reinterpret_cast<char *>(c) + header_size();
+			_remaining = size - header_size();
+			if (size <= std::numeric_limits<std::size_t>::max() / 2)
+				_next_size = size * 2;
+		}
+
+		void init(void *buffer, std::size_t size, std::size_t next_size, memory_resource *upstream) {
+			_upstream = upstream;
+			_initial_buffer = buffer;
+			_initial_size = size;
+			_initial_next_size = std::max<std::size_t>(next_size, header_size() + 1);
+			_current = static_cast<char *>(buffer);
+			_remaining = size;
+			_next_size = _initial_next_size;
+			_chunks = 0;
+		}
+
+	public:
+		explicit monotonic_buffer_resource(memory_resource *upstream = get_default_resource())
+			{ init(0, 0, default_next_size, upstream); }
+		explicit monotonic_buffer_resource(std::size_t initial_size, memory_resource *upstream = get_default_resource())
+			{ init(0, 0, initial_size, upstream); }
+		// Hands out `buffer` first and only then goes to the upstream.
+		monotonic_buffer_resource(void *buffer, std::size_t size, memory_resource *upstream = get_default_resource())
+			{ init(buffer, size, std::max<std::size_t>(size * 2, default_next_size), upstream); }
+
+		~monotonic_buffer_resource() { release(); }
+
+		memory_resource *upstream_resource() const { return _upstream; }
+
+		void release() {
+			while (_chunks) {
+				chunk *c = _chunks;
+				_chunks = c->next;
+				_upstream->deallocate(c, c->size, max_align);
+			}
+			_current = static_cast<char *>(_initial_buffer);
+			_remaining = _initial_size;
+			_next_size = _initial_next_size;
+		}
+
+	protected:
+		void *do_allocate(std::size_t bytes, std::size_t alignment) {
+			std::size_t pad = align_up(reinterpret_cast<std::size_t>(_current), alignment) - reinterpret_cast<std::size_t>(_current);
+			if (!_current || pad > _remaining || bytes > _remaining - pad) {
+				newChunk(bytes + (alignment > max_align ? alignment : 0));
+				pad = align_up(reinterpret_cast<std::size_t>(_current), alignment) - reinterpret_cast<std::size_t>(_current);
+			}
+			char *p = _current + pad;
+			_current = p + bytes;
+			_remaining -= pad + bytes;
+			return p;
+		}
+
+		void do_deallocate(void *, std::size_t, std::size_t) {}
+
+		bool do_is_equal(const memory_resource &other) const { return this == &other; }
+	};
+
+	struct pool_options {
+		std::size_t	max_blocks_per_chunk;
+		std::size_t	largest_required_pool_block;
+
+		pool_options() : max_blocks_per_chunk(0), largest_required_pool_block(0) {}
+	};
+
+	// Segregated free lists for power-of-two block sizes from 8 bytes up to
+	// largest_required_pool_block. Each pool carves blocks out of chunks that
+	// double in size up to max_blocks_per_chunk blocks; freed blocks are reused
+	// by the same pool. Larger or over-aligned requests go straight to the
+	// upstream and are tracked so release() can return them too.
+	class unsynchronized_pool_resource : public memory_resource {
+		struct chunk {
+			chunk		*next;
+			std::size_t	size;
+		};
+
+		struct free_block {
+			free_block	*next;
+		};
+
+		struct large_block {
+			large_block	*prev;
+			large_block	*next;
+			std::size_t	size;
+			std::size_t	alignment;
+		};
+
+		struct pool {
+			free_block	*free;
+			char		*next;
+			char		*end;
+			chunk		*chunks;
+			std::size_t	next_blocks;
+		};
+
+		enum {
+			min_block = 8,
+			max_pools = 18,		// blocks of up to 1 MB
+			default_largest_block = 4096,
+			default_max_blocks = 1024
+		};
+
+		memory_resource	*_upstream;
+		pool_options	_options;
+		std::size_t		_pool_count;
+		pool			_pools[max_pools];
+		large_block		*_large;
+
+		unsynchronized_pool_resource(const unsynchronized_pool_resource &);
+		unsynchronized_pool_resource &operator=(const unsynchronized_pool_resource &);
+
+		static std::size_t chunk_header() { return align_up(sizeof(chunk), max_align); }
+		static std::size_t block_size(std::size_t index) { return min_block << index; }
+
+		static std::size_t large_header(std::size_t alignment)
+			{ return align_up(sizeof(large_block), alignment); }
+
+		void init(memory_resource *upstream, const pool_options &options) {
+			_upstream = upstream;
+			_options = options;
+			if (!_options.max_blocks_per_chunk)
+				_options.max_blocks_per_chunk = default_max_blocks;
+			if (!_options.largest_required_pool_block)
+				_options.largest_required_pool_block = default_largest_block;
+			_options.largest_required_pool_block = std::min(std::max<std::size_t>(_options.largest_required_pool_block, min_block),
+															block_size(max_pools - 1));
+			_pool_count = 0;
+			while (block_size(_pool_count) < _options.largest_required_pool_block)
+				++_pool_count;
+			_options.largest_required_pool_block = block_size(_pool_count++);
+			for (std::size_t i = 0; i < _pool_count; ++i) {
+				_pools[i].free = 0;
+				_pools[i].next = 0;
+				_pools[i].end = 0;
+				_pools[i].chunks = 0;
+				_pools[i].next_blocks = std::max<std::size_t>(1, std::min(_options.max_blocks_per_chunk,
+																		  1024 / block_size(i)));
+			}
+			_large = 0;
+		}
+
+		// Index of the smallest pool that fits the request, or _pool_count if none does.
+		std::size_t poolIndex(std::size_t bytes, std::size_t alignment) const {
+			if (alignment > max_align)
+				return _pool_count;
+			std::size_t size = std::max(bytes, alignment);
+			std::size_t index = 0;
+			while (index < _pool_count && block_size(index) < size)
+				++index;
+			return index;
+		}
+
+		void refill(pool &p, std::size_t index) {
+			std::size_t size = chunk_header() + p.next_blocks * block_size(index);
+			chunk *c = static_cast<chunk *>(_upstream->allocate(size, max_align));
+			c->next = p.chunks;
+			c->size = size;
+			p.chunks = c;
+			p.next = reinterpret_cast<char *>(c) + chunk_header();
+			p.end = reinterpret_cast<char *>(c) + size;
+			p.next_blocks = std::min(p.next_blocks * 2, _options.max_blocks_per_chunk);
+		}
+
+		void *allocateLarge(std::size_t bytes, std::size_t alignment) {
+			alignment = std::max(alignment, max_align);
+			std::size_t header = large_header(alignment);
+			if (bytes > std::numeric_limits<std::size_t>::max() - header)
+				throw std::bad_alloc();
+			large_block *b = static_cast<large_block *>(_upstream->allocate(header + bytes, alignment));
+			b->prev = 0;
+			b->next = _large;
+			b->size = header + bytes;
+			b->alignment = alignment;
+			if (_large)
+				_large->prev = b;
+			_large = b;
+			return reinterpret_cast<char *>(b) + header;
+		}
+
+		void deallocateLarge(void *p, std::size_t alignment) {
+			alignment = std::max(alignment, max_align);
+			large_block *b = reinterpret_cast<large_block *>(static_cast<char *>(p) - large_header(alignment));
+			if (b->prev)
+				b->prev->next = b->next;
+			else
+				_large = b->next;
+			if (b->next)
+				b->next->prev = b->prev;
+			_upstream->deallocate(b, b->size, b->alignment);
+		}
+
+	public:
+		explicit unsynchronized_pool_resource(memory_resource *upstream = get_default_resource())
+			{ init(upstream, pool_options()); }
+		explicit unsynchronized_pool_resource(const pool_options &options, memory_resource *upstream = get_default_resource())
+			{ init(upstream, options); }
+
+		~unsynchronized_pool_resource() { release(); }
+
+		memory_resource *upstream_resource() const { return _upstream; }
+		pool_options options() const { return _options; }
+
+		// Returns every chunk and large block to the upstream, even those still in use.
+		void release() {
+			for (std::size_t i = 0; i < _pool_count; ++i) {
+				pool &p = _pools[i];
+				while (p.chunks) {
+					chunk *c = p.chunks;
+					p.chunks = c->next;
+					_upstream->deallocate(c, c->size, max_align);
+				}
+				p.free = 0;
+				p.next = 0;
+				p.end = 0;
+			}
+			while (_large) {
+				large_block *b = _large;
+				_large = b->next;
+				_upstream->deallocate(b, b->size, b->alignment);
+			}
+		}
+
+	protected:
+		void *do_allocate(std::size_t bytes, std::size_t alignment) {
+			std::size_t index = poolIndex(bytes, alignment);
+			if (index == _pool_count)
+				return allocateLarge(bytes, alignment);
+			pool &p = _pools[index];
+			if (p.free) {
+				free_block *b = p.free;
+				p.free = b->next;
+				return b;
+			}
+			if (p.next == p.end)
+				refill(p, index);
+			void *b = p.next;
+			p.next += block_size(index);
+			return b;
+		}
+
+		void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) {
+			if (!ptr)
+				return;
+			std::size_t index = poolIndex(bytes, alignment);
+			if (index == _pool_count)
+				return deallocateLarge(ptr, alignment);
+			free_block *b = static_cast<free_block *>(ptr);
+			b->next = _pools[index].free;
+			_pools[index].free = b;
+		}
+
+		bool do_is_equal(const memory_resource &other) const { return this == &other; }
+	};
+
+	// unsynchronized_pool_resource behind a mutex, for resources shared between threads.
+	class synchronized_pool_resource : public memory_resource {
+		unsynchronized_pool_resource	_pool;
+		mutable pthread_mutex_t			_lock;
+
+		synchronized_pool_resource(const synchronized_pool_resource &);
+		synchronized_pool_resource &operator=(const synchronized_pool_resource &);
+
+		struct guard {
+			pthread_mutex_t	*lock;
+			explicit guard(pthread_mutex_t *l) : lock(l) { pthread_mutex_lock(lock); }
+			~guard() { pthread_mutex_unlock(lock); }
+		};
+
+	public:
+		explicit synchronized_pool_resource(memory_resource *upstream = get_default_resource())
+			: _pool(upstream) { pthread_mutex_init(&_lock, 0); }
+		explicit synchronized_pool_resource(const pool_options &options, memory_resource *upstream = get_default_resource())
+			: _pool(options, upstream) { pthread_mutex_init(&_lock, 0); }
+
+		~synchronized_pool_resource() { pthread_mutex_destroy(&_lock); }
+
+		memory_resource *upstream_resource() const { return _pool.upstream_resource(); }
+		pool_options options() const { return _pool.options(); }
+
+		void release() {
+			guard g(&_lock);
+			_pool.release();
+		}
+
+	protected:
+		void *do_allocate(std::size_t bytes, std::size_t alignment) {
+			guard g(&_lock);
+			return _pool.allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) {
+			guard g(&_lock);
+			_pool.deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const memory_resource &other) const { return this == &other; }
+	};
+
+	// C++98-style allocator over a memory_resource, usable as the `A` parameter
+	// of every container. Copies and rebinds share the resource, so a Map's
+	// nodes, their values and the tree header all come from the same arena.
+	template <class T>
+	class polymorphic_allocator {
+		template <class U> friend class polymorphic_allocator;
+
+		memory_resource	*_resource;
+
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <class U>
+		struct rebind { typedef polymorphic_allocator<U> other; };
+
+		polymorphic_allocator() : _resource(get_default_resource()) {}
+		polymorphic_allocator(memory_resource *resource) : _resource(resource) {}
+		polymorphic_allocator(const polymorphic_allocator &other) : _resource(other._resource) {}
+		template <class U>
+		polymorphic_allocator(const polymorphic_allocator<U> &other) : _resource(other._resource) {}
+		~polymorphic_allocator() {}
+
+		polymorphic_allocator &operator=(const polymorphic_allocator &other)
+			{ _resource = other._resource; return *this; }
+
+		memory_resource *resource() const { return _resource; }
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		pointer allocate(size_type n, const void * = 0) {
+			if (n > max_size())
+				throw std::bad_alloc();
+			return static_cast<pointer>(_resource->allocate(n * sizeof(T), __alignof__(T)));
+		}
+
+		void deallocate(pointer p, size_type n) { _resource->deallocate(p, n * sizeof(T), __alignof__(T)); }
+
+		void construct(pointer p, const_reference value) { new (p) T(value); }
+#if __cplusplus >= 201103L
+		template <class U, class... Args>
+		void construct(U *p, Args&&... args) { new (p) U(std::forward<Args>(args)...); }
+#endif
+		void destroy(pointer p) { p->~T(); }
+		size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+		template <class U>
+		bool operator==(const polymorphic_allocator<U> &other) const { return *_resource == *other._resource; }
+		template <class U>
+		bool operator!=(const polymorphic_allocator<U> &other) const { return !(*_resource == *other._resource); }
+	};
+}
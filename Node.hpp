@@ -1,16 +1,20 @@
 #pragma once
 
 #include <algorithm>
+#include <new>
+#include "Reclaimer.hpp"
+#include "Stats.hpp"
+#include "Utility.hpp"
 
+// The value lives in a block of its own that the container allocates and frees
+// through its allocator (see Tree::createNode); the sentinel has none.
 template <class value_type>
 struct Node_ {
 public:
 	Node_()
-		: color(0), begin(NULL), left(this), right(this), parent(0), NIL(1), pair(new value_type()) {}
-	Node_(const value_type& p)
-		: color(0), begin(NULL), left(this), right(this), parent(0), NIL(0), pair(new value_type(p)) {}
-	~Node_()
-		{ delete pair; }
+		: color(0), begin(NULL), left(this), right(this), parent(0), NIL(1), pair(0) {}
+	explicit Node_(value_type *p)
+		: color(0), begin(NULL), left(this), right(this), parent(0), NIL(0), pair(p) {}
 	bool color;
 	struct Node_ *begin;
 	struct Node_ *left;
@@ -26,6 +30,9 @@ public:
 	Node_<value_type> sentinel;
 	Node_<value_type> *root;
 	size_t m_size;
+#ifdef FT_STATS
+	ft::tree_stats stats;
+#endif
 	Tree() : m_size(0)
 	{
 		sentinel.left = &sentinel;
@@ -61,6 +68,7 @@ public:
 	void rotateLeft(Node_<value_type> *x) {
 		Node_<value_type> *y = x->right;
 
+		FT_STAT(++stats.rotate_left);
 		x->right = y->left;
 		if (!y->left->NIL)
 			y->left->parent = x;
@@ -82,6 +90,7 @@ public:
 	void rotateRight(Node_<value_type> *x) {
 		Node_<value_type> *y = x->left;
 
+		FT_STAT(++stats.rotate_right);
 		x->left = y->right;
 		if (!y->right->NIL)
 			y->right->parent = x;
@@ -103,6 +112,7 @@ public:
 	{
 		while (x != root && x->parent->color == 1)
 		{
+			FT_STAT(++stats.insert_fixup_iterations);
 			if (x->parent == x->parent->parent->left)
 			{
 				Node_<value_type> *y = x->parent->parent->right;
@@ -152,6 +162,7 @@ public:
 	{
 		while (x != root && x->color == 0)
 		{
+			FT_STAT(++stats.delete_fixup_iterations);
 			if (x == x->parent->left)
 			{
 				Node_<value_type> *w = x->parent->right;
@@ -213,7 +224,10 @@ public:
 		x->color = 0;
 	}
 
-	int deleteNode(Node_<value_type> *z)
+	// Unlinks z and returns the node that left the tree, which the caller frees.
+	// When z has two children its successor is unlinked instead and the values
+	// of the two nodes are exchanged, so the returned node carries z's value.
+	Node_<value_type> *deleteNode(Node_<value_type> *z)
 	{
 		Node_<value_type> *x, *y;
 
@@ -244,23 +258,80 @@ public:
 		else
 			root = x;
 		if (y != z)
-		{
-			delete z->pair;
-			value_type *p = new value_type(*y->pair);
-			z->pair = p;
-		}
+			std::swap(z->pair, y->pair);
 
 		if (y->color == 0)
 			deleteFixup (x);
 		sentinel.parent = getLast();
 		sentinel.begin = getBegin();
 		m_size--;
-		delete y;
-		return 1;
+		return y;
+	}
+
+	// Allocates a node and its value, the value through value_alloc.
+	template <class NodeAllocator, class ValueAllocator>
+	static Node_<value_type> *createNode(NodeAllocator &node_alloc, ValueAllocator &value_alloc, const value_type &value) {
+		value_type *v = ft::node_storage_traits<ValueAllocator>::allocate(value_alloc);
+		try {
+			value_alloc.construct(v, value);
+		} catch (...) {
+			ft::node_storage_traits<ValueAllocator>::deallocate(value_alloc, v);
+			throw;
+		}
+		Node_<value_type> *x;
+		try {
+			x = ft::node_storage_traits<NodeAllocator>::allocate(node_alloc);
+		} catch (...) {
+			value_alloc.destroy(v);
+			ft::node_storage_traits<ValueAllocator>::deallocate(value_alloc, v);
+			throw;
+		}
+		node_alloc.construct(x, Node_<value_type>(v));
+		return x;
+	}
+
+	template <class NodeAllocator, class ValueAllocator>
+	static void destroyNode(NodeAllocator &node_alloc, ValueAllocator &value_alloc, Node_<value_type> *x) {
+		value_alloc.destroy(x->pair);
+		ft::node_storage_traits<ValueAllocator>::deallocate(value_alloc, x->pair);
+		node_alloc.destroy(x);
+		ft::node_storage_traits<NodeAllocator>::deallocate(node_alloc, x);
+	}
+
+	// Empties the tree and returns its old root; the nodes are left for destroyNodes.
+	Node_<value_type> *detachNodes() {
+		Node_<value_type> *old = root;
+		root = &sentinel;
+		sentinel.parent = 0;
+		sentinel.begin = &sentinel;
+		m_size = 0;
+		return old;
+	}
+
+	// Frees the nodes under x with no recursion and O(1) extra space: while x
+	// has a left child, rotate it right; otherwise x is the smallest node left,
+	// so free it and continue with its right subtree. Leaves are recognised by
+	// the address of the sentinel, which is never read, so the tree header may
+	// already be gone.
+	template <class NodeAllocator, class ValueAllocator>
+	static void destroyNodes(NodeAllocator &node_alloc, ValueAllocator &value_alloc, Node_<value_type> *x, const Node_<value_type> *nil) {
+		while (x != nil) {
+			Node_<value_type> *l = x->left;
+			if (l != nil) {
+				x->left = l->right;
+				l->right = x;
+				x = l;
+			} else {
+				Node_<value_type> *r = x->right;
+				destroyNode(node_alloc, value_alloc, x);
+				x = r;
+			}
+		}
 	}
 
 	Node_<value_type>* getBegin() {
 		Node_<value_type>* tmp = root;
+		FT_STAT(++stats.begin_walks);
 		while (!tmp->left->NIL)
 			tmp = tmp->left;
 		return tmp;
@@ -268,6 +339,7 @@ public:
 
 	Node_<value_type>* getLast() {
 		Node_<value_type>* tmp = root;
+		FT_STAT(++stats.last_walks);
 		while (!tmp->right->NIL)
 			tmp = tmp->right;
 		return tmp;
@@ -275,8 +347,57 @@ public:
 
 	Node_<value_type>* getEnd() {
 		Node_<value_type>* tmp = root;
+		FT_STAT(++stats.last_walks);
 		while (!tmp->right->NIL)
 			tmp = tmp->right;
 		return tmp->right;
 	}
-};
\ No newline at end of file
+
+#ifdef FT_STATS
+	size_t height() const {
+		return height(root);
+	}
+
+	static size_t height(const Node_<value_type> *node) {
+		if (node->NIL)
+			return 0;
+		return 1 + std::max(height(node->left), height(node->right));
+	}
+#endif
+};
+
+// Empties a Tree, freeing its nodes inline or, when the owner opted in and the
+// tree is large, on ft::background_reclaimer. The allocators are copied into
+// the job and used on that thread, so owners only opt in for allocators with
+// ft::is_thread_safe_allocator.
+template <class value_type, class NodeAllocator, class ValueAllocator>
+struct tree_teardown : public ft::reclaim_job {
+	enum { deferred_min_size = 4096 };
+
+	NodeAllocator			node_alloc;
+	ValueAllocator			value_alloc;
+	Node_<value_type>		*root;
+	const Node_<value_type>	*nil;
+
+	tree_teardown(const NodeAllocator &na, const ValueAllocator &va, Node_<value_type> *r, const Node_<value_type> *n)
+		: ft::reclaim_job(&tree_teardown::reclaim), node_alloc(na), value_alloc(va), root(r), nil(n) {}
+
+	static void release(NodeAllocator &na, ValueAllocator &va, Tree<value_type> &t, bool deferred) {
+		bool large = t.m_size >= deferred_min_size;
+		Node_<value_type> *nodes = t.detachNodes();
+		if (deferred && large) {
+			tree_teardown *job = new (std::nothrow) tree_teardown(na, va, nodes, &t.sentinel);
+			if (job) {
+				ft::background_reclaimer::defer(job);
+				return;
+			}
+		}
+		Tree<value_type>::destroyNodes(na, va, nodes, &t.sentinel);
+	}
+
+	static void reclaim(ft::reclaim_job *job) {
+		tree_teardown *self = static_cast<tree_teardown *>(job);
+		Tree<value_type>::destroyNodes(self->node_alloc, self->value_alloc, self->root, self->nil);
+		delete self;
+	}
+};
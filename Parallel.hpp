@@ -0,0 +1,485 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <pthread.h>
+#include <unistd.h>
+#if __cplusplus >= 201103L
+# include <exception>
+#endif
+
+#include "Deque.hpp"
+#include "Vector.hpp"
+
+namespace ft {
+	// Fixed set of pthread workers, each with its own task deque. A worker pops
+	// its newest task from the back and, when idle, steals the oldest task from
+	// the front of another worker's deque, so nested fork/join work stays local
+	// and load spreads out only when someone runs dry. Threads waiting for a
+	// task_group run queued tasks, and sleep only when there are none.
+	class ThreadPool {
+	public:
+		struct task_group {
+			std::size_t			pending;
+			bool				failed;
+#if __cplusplus >= 201103L
+			std::exception_ptr	error;
+#endif
+			task_group() : pending(0), failed(false) {}
+		};
+
+	private:
+		struct task {
+			void		(*run)(void *);
+			void		*arg;
+			task_group	*group;
+		};
+
+		struct worker {
+			pthread_mutex_t		lock;
+			ft::Deque<task>		tasks;
+			pthread_t			thread;
+			ThreadPool			*pool;
+		};
+
+		ft::Vector<worker *>	_workers;
+		pthread_mutex_t			_sleep_lock;
+		pthread_cond_t			_wake;
+		pthread_cond_t			_done;		// some group finished, or work arrived for waiters
+		std::size_t				_waiters;	// threads asleep in wait(), under _sleep_lock
+		std::size_t				_queued;
+		std::size_t				_next;
+		bool					_stop;
+
+		ThreadPool(const ThreadPool &);
+		ThreadPool &operator=(const ThreadPool &);
+
+		static worker *&current() {
+			static __thread worker *self = 0;
+			return self;
+		}
+
+		worker *self() const {
+			worker *w = current();
+			return w && w->pool == this ? w : 0;
+		}
+
+		bool popTask(worker *w, task &out, bool back) {
+			pthread_mutex_lock(&w->lock);
+			bool found = !w->tasks.empty();
+			if (found) {
+				out = back ? w->tasks.back() : w->tasks.front();
+				if (back)
+					w->tasks.pop_back();
+				else
+					w->tasks.pop_front();
+			}
+			pthread_mutex_unlock(&w->lock);
+			return found;
+		}
+
+		bool findTask(worker *me, task &out) {
+			if (me && popTask(me, out, true))
+				return true;
+			std::size_t n = _workers.size();
+			std::size_t start = __atomic_fetch_add(&_next, 1, __ATOMIC_RELAXED);
+			for (std::size_t i = 0; i < n; ++i) {
+				worker *victim = _workers[(start + i) % n];
+				if (victim != me && popTask(victim, out, false))
+					return true;
+			}
+			return false;
+		}
+
+		void execute(const task &t) {
+			try {
+				t.run(t.arg);
+			} catch (...) {
+				if (!__atomic_exchange_n(&t.group->failed, true, __ATOMIC_ACQ_REL)) {
+#if __cplusplus >= 201103L
+					t.group->error = std::current_exception();
+#endif
+				}
+			}
+			// The group may be gone as soon as pending reaches zero.
+			if (__atomic_sub_fetch(&t.group->pending, 1, __ATOMIC_ACQ_REL))
+				return;
+			pthread_mutex_lock(&_sleep_lock);
+			if (_waiters)
+				pthread_cond_broadcast(&_done);
+			pthread_mutex_unlock(&_sleep_lock);
+		}
+
+		bool runOne(worker *me) {
+			task t;
+			if (!findTask(me, t))
+				return false;
+			__atomic_sub_fetch(&_queued, 1, __ATOMIC_RELAXED);
+			execute(t);
+			return true;
+		}
+
+		static void *workerMain(void *arg) {
+			worker *me = static_cast<worker *>(arg);
+			ThreadPool *pool = me->pool;
+			current() = me;
+			for (;;) {
+				if (pool->runOne(me))
+					continue;
+				pthread_mutex_lock(&pool->_sleep_lock);
+				while (!pool->_stop && !__atomic_load_n(&pool->_queued, __ATOMIC_ACQUIRE))
+					pthread_cond_wait(&pool->_wake, &pool->_sleep_lock);
+				bool stop = pool->_stop;
+				pthread_mutex_unlock(&pool->_sleep_lock);
+				if (stop)
+					return 0;
+			}
+		}
+
+		// Stops the workers; only the first `started` of them have a thread to join.
+		// All of them are joined before any is freed, since a running worker may
+		// still be stealing from the others.
+		void shutdown(std::size_t started) {
+			pthread_mutex_lock(&_sleep_lock);
+			_stop = true;
+			pthread_cond_broadcast(&_wake);
+			pthread_mutex_unlock(&_sleep_lock);
+			for (std::size_t i = 0; i < started; ++i)
+				pthread_join(_workers[i]->thread, 0);
+			for (std::size_t i = 0; i < _workers.size(); ++i) {
+				pthread_mutex_destroy(&_workers[i]->lock);
+				delete _workers[i];
+			}
+			_workers.clear();
+			pthread_cond_destroy(&_done);
+			pthread_cond_destroy(&_wake);
+			pthread_mutex_destroy(&_sleep_lock);
+		}
+
+	public:
+		static std::size_t hardware_concurrency() {
+			long n = sysconf(_SC_NPROCESSORS_ONLN);
+			return n > 0 ? n : 1;
+		}
+
+		// `threads` workers are started; the thread calling wait() works as well,
+		// so ThreadPool(0) runs everything on the caller.
+		explicit ThreadPool(std::size_t threads = hardware_concurrency()) : _waiters(0), _queued(0), _next(0), _stop(false) {
+			pthread_mutex_init(&_sleep_lock, 0);
+			pthread_cond_init(&_wake, 0);
+			pthread_cond_init(&_done, 0);
+			std::size_t started = 0;
+			try {
+				_workers.reserve(threads);
+				for (std::size_t i = 0; i < threads; ++i) {
+					_workers.push_back(new worker());
+					pthread_mutex_init(&_workers[i]->lock, 0);
+					_workers[i]->pool = this;
+				}
+				// Every worker is registered before any thread starts stealing.
+				for (; started < threads; ++started)
+					if (pthread_create(&_workers[started]->thread, 0, workerMain, _workers[started]) != 0)
+						throw std::runtime_error("ThreadPool: cannot create thread");
+			} catch (...) {
+				shutdown(started);
+				throw;
+			}
+		}
+
+		~ThreadPool() { shutdown(_workers.size()); }
+
+		std::size_t size() const { return _workers.size(); }
+
+		void submit(task_group &group, void (*run)(void *), void *arg) {
+			task t = { run, arg, &group };
+			__atomic_add_fetch(&group.pending, 1, __ATOMIC_RELAXED);
+			if (_workers.empty()) {
+				execute(t);
+				return;
+			}
+			worker *w = self();
+			if (!w)
+				w = _workers[__atomic_fetch_add(&_next, 1, __ATOMIC_RELAXED) % _workers.size()];
+			pthread_mutex_lock(&w->lock);
+			try {
+				w->tasks.push_back(t);
+			} catch (...) {
+				pthread_mutex_unlock(&w->lock);
+				__atomic_sub_fetch(&group.pending, 1, __ATOMIC_RELAXED);
+				throw;
+			}
+			pthread_mutex_unlock(&w->lock);
+			__atomic_add_fetch(&_queued, 1, __ATOMIC_RELEASE);
+			pthread_mutex_lock(&_sleep_lock);
+			pthread_cond_signal(&_wake);
+			if (_waiters)
+				pthread_cond_broadcast(&_done);
+			pthread_mutex_unlock(&_sleep_lock);
+		}
+
+		// Runs queued tasks until every task of `group` has finished, then rethrows
+		// the first exception one of them raised. With nothing left to run it
+		// sleeps until the group finishes or more work is queued.
+		void wait(task_group &group) {
+			worker *me = self();
+			while (__atomic_load_n(&group.pending, __ATOMIC_ACQUIRE)) {
+				if (runOne(me))
+					continue;
+				pthread_mutex_lock(&_sleep_lock);
+				++_waiters;
+				while (__atomic_load_n(&group.pending, __ATOMIC_ACQUIRE) && !__atomic_load_n(&_queued, __ATOMIC_ACQUIRE))
+					pthread_cond_wait(&_done, &_sleep_lock);
+				--_waiters;
+				pthread_mutex_unlock(&_sleep_lock);
+			}
+			if (group.failed) {
+				group.failed = false;
+#if __cplusplus >= 201103L
+				std::exception_ptr error = group.error;
+				group.error = std::exception_ptr();
+				std::rethrow_exception(error);
+#else
+				throw std::runtime_error("ThreadPool: task failed");
+#endif
+			}
+		}
+	};
+
+	// Worker count of default_thread_pool(); 0 means one per online CPU. Only
+	// takes effect if set before the pool is first used.
+	inline std::size_t &default_thread_count() {
+		static std::size_t count = 0;
+		return count;
+	}
+
+	inline ThreadPool &default_thread_pool() {
+		static ThreadPool pool(default_thread_count() ? default_thread_count() : ThreadPool::hardware_concurrency());
+		return pool;
+	}
+
+	// Ranges shorter than this are not split any further.
+	static const std::size_t	parallel_grain = 4096;
+
+	template <class Body>
+	struct parallel_chunk {
+		Body		*body;
+		std::size_t	index;
+		std::size_t	lo;
+		std::size_t	hi;
+
+		static void run(void *arg) {
+			parallel_chunk *c = static_cast<parallel_chunk *>(arg);
+			(*c->body)(c->index, c->lo, c->hi);
+		}
+	};
+
+	inline std::size_t parallel_chunks(ThreadPool &pool, std::size_t n) {
+		std::size_t chunks = std::min(n / parallel_grain, (pool.size() + 1) * 4);
+		return chunks ? chunks : 1;
+	}
+
+	// Calls body(index, lo, hi) for `chunks` consecutive slices of [0, n) and
+	// returns once all of them are done. The caller runs the first slice itself.
+	template <class Body>
+	void parallel_run(ThreadPool &pool, std::size_t n, std::size_t chunks, Body &body) {
+		if (chunks <= 1) {
+			body(0, 0, n);
+			return;
+		}
+		ft::Vector<parallel_chunk<Body> > parts;
+		parts.reserve(chunks);
+		for (std::size_t i = 0; i < chunks; ++i) {
+			parallel_chunk<Body> c = { &body, i, n * i / chunks, n * (i + 1) / chunks };
+			parts.push_back(c);
+		}
+		ThreadPool::task_group group;
+		try {
+			for (std::size_t i = 1; i < chunks; ++i)
+				pool.submit(group, parallel_chunk<Body>::run, &parts[i]);
+			body(0, parts[0].lo, parts[0].hi);
+		} catch (...) {
+			try {
+				pool.wait(group);
+			} catch (...) {}
+			throw;
+		}
+		pool.wait(group);
+	}
+
+	template <class RandomIt, class UnaryFunction>
+	struct for_each_body {
+		RandomIt		first;
+		UnaryFunction	f;
+		void operator()(std::size_t, std::size_t lo, std::size_t hi) { std::for_each(first + lo, first + hi, f); }
+	};
+
+	template <class RandomIt1, class RandomIt2, class UnaryOperation>
+	struct transform_body {
+		RandomIt1		first;
+		RandomIt2		out;
+		UnaryOperation	op;
+		void operator()(std::size_t, std::size_t lo, std::size_t hi) { std::transform(first + lo, first + hi, out + lo, op); }
+	};
+
+	template <class RandomIt1, class RandomIt2>
+	struct copy_body {
+		RandomIt1	first;
+		RandomIt2	out;
+		void operator()(std::size_t, std::size_t lo, std::size_t hi) { std::copy(first + lo, first + hi, out + lo); }
+	};
+
+	template <class RandomIt, class T, class BinaryOperation>
+	struct reduce_body {
+		RandomIt			first;
+		BinaryOperation		op;
+		ft::Vector<T>		*partial;
+		void operator()(std::size_t index, std::size_t lo, std::size_t hi) {
+			T acc = first[lo];
+			for (++lo; lo < hi; ++lo)
+				acc = op(acc, first[lo]);
+			(*partial)[index] = acc;
+		}
+	};
+
+	template <class RandomIt, class Compare>
+	struct sort_body {
+		RandomIt			first;
+		Compare				comp;
+		const std::size_t	*bounds;
+		void operator()(std::size_t index, std::size_t, std::size_t)
+			{ std::sort(first + bounds[index], first + bounds[index + 1], comp); }
+	};
+
+	template <class RandomIt1, class RandomIt2, class Compare>
+	struct merge_body {
+		RandomIt1			src;
+		RandomIt2			dst;
+		Compare				comp;
+		const std::size_t	*bounds;
+		std::size_t			width;
+		std::size_t			chunks;
+		void operator()(std::size_t index, std::size_t, std::size_t) {
+			std::size_t a = index * 2 * width;
+			std::size_t lo = bounds[a];
+			std::size_t mid = bounds[std::min(a + width, chunks)];
+			std::size_t hi = bounds[std::min(a + 2 * width, chunks)];
+			std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+		}
+	};
+
+	template <class RandomIt, class UnaryFunction>
+	void parallel_for_each(ThreadPool &pool, RandomIt first, RandomIt last, UnaryFunction f) {
+		std::size_t n = last - first;
+		for_each_body<RandomIt, UnaryFunction> body = { first, f };
+		parallel_run(pool, n, parallel_chunks(pool, n), body);
+	}
+
+	template <class RandomIt1, class RandomIt2, class UnaryOperation>
+	RandomIt2 parallel_transform(ThreadPool &pool, RandomIt1 first, RandomIt1 last, RandomIt2 out, UnaryOperation op) {
+		std::size_t n = last - first;
+		transform_body<RandomIt1, RandomIt2, UnaryOperation> body = { first, out, op };
+		parallel_run(pool, n, parallel_chunks(pool, n), body);
+		return out + n;
+	}
+
+	template <class RandomIt1, class RandomIt2>
+	RandomIt2 parallel_copy(ThreadPool &pool, RandomIt1 first, RandomIt1 last, RandomIt2 out) {
+		std::size_t n = last - first;
+		copy_body<RandomIt1, RandomIt2> body = { first, out };
+		parallel_run(pool, n, parallel_chunks(pool, n), body);
+		return out + n;
+	}
+
+	// Folds the range into `init` with `op`, which must be associative; the
+	// order of the operands is kept, so it need not be commutative.
+	template <class RandomIt, class T, class BinaryOperation>
+	T parallel_reduce(ThreadPool &pool, RandomIt first, RandomIt last, T init, BinaryOperation op) {
+		std::size_t n = last - first;
+		if (!n)
+			return init;
+		std::size_t chunks = parallel_chunks(pool, n);
+		ft::Vector<T> partial(chunks, init);
+		reduce_body<RandomIt, T, BinaryOperation> body = { first, op, &partial };
+		parallel_run(pool, n, chunks, body);
+		for (std::size_t i = 0; i < chunks; ++i)
+			init = op(init, partial[i]);
+		return init;
+	}
+
+	template <class RandomIt, class T>
+	T parallel_reduce(ThreadPool &pool, RandomIt first, RandomIt last, T init) {
+		return parallel_reduce(pool, first, last, init, std::plus<T>());
+	}
+
+	// Merge sort: the slices are sorted in parallel, then merged pairwise in
+	// log2(slices) rounds that alternate between the range and a scratch copy.
+	// Not stable across slices.
+	template <class RandomIt, class Compare>
+	void parallel_sort(ThreadPool &pool, RandomIt first, RandomIt last, Compare comp) {
+		typedef typename ft::iterator_traits<RandomIt>::value_type	value_type;
+		std::size_t n = last - first;
+		std::size_t chunks = parallel_chunks(pool, n);
+		if (chunks < 2) {
+			std::sort(first, last, comp);
+			return;
+		}
+		ft::Vector<std::size_t> bounds;
+		bounds.reserve(chunks + 1);
+		for (std::size_t i = 0; i <= chunks; ++i)
+			bounds.push_back(n * i / chunks);
+		sort_body<RandomIt, Compare> sorter = { first, comp, bounds.data() };
+		parallel_run(pool, n, chunks, sorter);
+
+		ft::Vector<value_type> scratch(first, last);
+		bool in_scratch = false;
+		for (std::size_t width = 1; width < chunks; width *= 2) {
+			std::size_t merges = (chunks + 2 * width - 1) / (2 * width);
+			if (in_scratch) {
+				merge_body<typename ft::Vector<value_type>::iterator, RandomIt, Compare>
+					body = { scratch.begin(), first, comp, bounds.data(), width, chunks };
+				parallel_run(pool, merges, merges, body);
+			} else {
+				merge_body<RandomIt, typename ft::Vector<value_type>::iterator, Compare>
+					body = { first, scratch.begin(), comp, bounds.data(), width, chunks };
+				parallel_run(pool, merges, merges, body);
+			}
+			in_scratch = !in_scratch;
+		}
+		if (in_scratch)
+			parallel_copy(pool, scratch.begin(), scratch.end(), first);
+	}
+
+	template <class RandomIt>
+	void parallel_sort(ThreadPool &pool, RandomIt first, RandomIt last) {
+		parallel_sort(pool, first, last, std::less<typename ft::iterator_traits<RandomIt>::value_type>());
+	}
+
+	template <class RandomIt, class UnaryFunction>
+	void parallel_for_each(RandomIt first, RandomIt last, UnaryFunction f)
+		{ parallel_for_each(default_thread_pool(), first, last, f); }
+
+	template <class RandomIt1, class RandomIt2, class UnaryOperation>
+	RandomIt2 parallel_transform(RandomIt1 first, RandomIt1 last, RandomIt2 out, UnaryOperation op)
+		{ return parallel_transform(default_thread_pool(), first, last, out, op); }
+
+	template <class RandomIt1, class RandomIt2>
+	RandomIt2 parallel_copy(RandomIt1 first, RandomIt1 last, RandomIt2 out)
+		{ return parallel_copy(default_thread_pool(), first, last, out); }
+
+	template <class RandomIt, class T, class BinaryOperation>
+	T parallel_reduce(RandomIt first, RandomIt last, T init, BinaryOperation op)
+		{ return parallel_reduce(default_thread_pool(), first, last, init, op); }
+
+	template <class RandomIt, class T>
+	T parallel_reduce(RandomIt first, RandomIt last, T init)
+		{ return parallel_reduce(default_thread_pool(), first, last, init); }
+
+	template <class RandomIt, class Compare>
+	void parallel_sort(RandomIt first, RandomIt last, Compare comp)
+		{ parallel_sort(default_thread_pool(), first, last, comp); }
+
+	template <class RandomIt>
+	void parallel_sort(RandomIt first, RandomIt last)
+		{ parallel_sort(default_thread_pool(), first, last); }
+}
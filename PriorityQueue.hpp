@@ -0,0 +1,284 @@
+#pragma once
+
+#include <functional>
+#include <new>
+
+#include "Vector.hpp"
+
+namespace ft {
+	// Max-heap (with respect to Compare) adapter over a random-access container.
+	// Each node has D children: a 4-ary heap is half as deep as a binary one and
+	// the children of a node usually share a cache line, which makes pop cheaper.
+	template < class T, class Container = ft::Vector<T>, class Compare = std::less<typename Container::value_type>,
+			   std::size_t D = 4 >
+	class PriorityQueue {
+	public:
+		typedef	Container							container_type;
+		typedef Compare								value_compare;
+		typedef typename Container::value_type		value_type;
+		typedef typename Container::size_type		size_type;
+		typedef typename Container::reference		reference;
+		typedef typename Container::const_reference	const_reference;
+
+	private:
+		typedef char arity_check[D >= 2 ? 1 : -1];
+
+		Container	_container;
+		Compare		_comp;
+
+		void siftUp(size_type i) {
+			value_type value(FT_MOVE(_container[i]));
+			while (i) {
+				size_type parent = (i - 1) / D;
+				if (!_comp(_container[parent], value))
+					break;
+				_container[i] = FT_MOVE(_container[parent]);
+				i = parent;
+			}
+			_container[i] = FT_MOVE(value);
+		}
+
+		void siftDown(size_type i) {
+			size_type n = _container.size();
+			value_type value(FT_MOVE(_container[i]));
+			for (;;) {
+				size_type child = i * D + 1;
+				if (child >= n)
+					break;
+				size_type last = std::min(child + D, n);
+				size_type best = child;
+				for (++child; child < last; ++child)
+					if (_comp(_container[best], _container[child]))
+						best = child;
+				if (!_comp(value, _container[best]))
+					break;
+				_container[i] = FT_MOVE(_container[best]);
+				i = best;
+			}
+			_container[i] = FT_MOVE(value);
+		}
+
+		// Floyd's bottom-up construction: O(n) for the whole container.
+		void heapify() {
+			size_type n = _container.size();
+			if (n < 2)
+				return;
+			for (size_type i = (n - 2) / D + 1; i-- > 0;)
+				siftDown(i);
+		}
+
+	public:
+		explicit PriorityQueue(const Compare &compare = Compare(), const Container &cont = Container())
+			: _container(cont), _comp(compare) { heapify(); };
+
+		template <class InputIt>
+		PriorityQueue(InputIt first, InputIt last, const Compare &compare = Compare(), const Container &cont = Container(),
+					  typename ft::enable_if<!ft::is_integral<InputIt>::value, void>::type* = 0)
+			: _container(cont), _comp(compare) {
+			_container.insert(_container.end(), first, last);
+			heapify();
+		};
+
+		const_reference top() const { return _container.front(); };
+		bool empty() const { return _container.empty(); };
+		size_type size() const { return _container.size(); };
+		const container_type &container() const { return _container; };
+
+		void push(const value_type &value) {
+			_container.push_back(value);
+			siftUp(_container.size() - 1);
+		};
+
+#if __cplusplus >= 201103L
+		void push(value_type &&value) {
+			_container.push_back(std::move(value));
+			siftUp(_container.size() - 1);
+		};
+
+		template <class... Args>
+		void emplace(Args&&... args) {
+			_container.emplace_back(std::forward<Args>(args)...);
+			siftUp(_container.size() - 1);
+		};
+#endif
+
+		// Appends the range and restores the heap, rebuilding it from scratch when
+		// that is cheaper than sifting each new element up.
+		template <class InputIt>
+		typename ft::enable_if<!ft::is_integral<InputIt>::value, void>::type
+		push(InputIt first, InputIt last) {
+			size_type old_size = _container.size();
+			_container.insert(_container.end(), first, last);
+			size_type added = _container.size() - old_size;
+			if (added > old_size / 2)
+				heapify();
+			else
+				for (size_type i = old_size; i < _container.size(); ++i)
+					siftUp(i);
+		};
+
+		void pop() {
+			if (_container.size() > 1) {
+				_container.front() = FT_MOVE(_container.back());
+				_container.pop_back();
+				siftDown(0);
+			} else
+				_container.pop_back();
+		};
+
+		void swap(PriorityQueue &other) {
+			_container.swap(other._container);
+			std::swap(_comp, other._comp);
+		};
+	};
+
+	// D-ary heap that hands out a stable handle for every element, so a queued
+	// element can be re-prioritised or removed in O(log n). Handles of removed
+	// elements are recycled by later pushes. A removed value is overwritten with
+	// T() at once, so whatever it owns is not kept alive until its handle is
+	// reused; T must therefore be default constructible.
+	template < class T, class Compare = std::less<T>, std::size_t D = 4 >
+	class IndexedPriorityQueue {
+	public:
+		typedef T				value_type;
+		typedef Compare			value_compare;
+		typedef std::size_t		size_type;
+		typedef std::size_t		handle_type;
+		typedef const T&		const_reference;
+
+	private:
+		typedef char arity_check[D >= 2 ? 1 : -1];
+
+		static size_type npos() { return (size_type)-1; }
+
+		ft::Vector<handle_type>	_heap;		// heap order, holds handles
+		ft::Vector<T>			_values;	// indexed by handle
+		ft::Vector<size_type>	_position;	// heap index of each handle, npos if free
+		ft::Vector<handle_type>	_free;
+		Compare					_comp;
+
+		bool before(handle_type a, handle_type b) const { return _comp(_values[a], _values[b]); }
+
+		void place(size_type i, handle_type h) {
+			_heap[i] = h;
+			_position[h] = i;
+		}
+
+		void siftUp(size_type i) {
+			handle_type h = _heap[i];
+			while (i) {
+				size_type parent = (i - 1) / D;
+				if (!before(_heap[parent], h))
+					break;
+				place(i, _heap[parent]);
+				i = parent;
+			}
+			place(i, h);
+		}
+
+		void siftDown(size_type i) {
+			size_type n = _heap.size();
+			handle_type h = _heap[i];
+			for (;;) {
+				size_type child = i * D + 1;
+				if (child >= n)
+					break;
+				size_type last = std::min(child + D, n);
+				size_type best = child;
+				for (++child; child < last; ++child)
+					if (before(_heap[best], _heap[child]))
+						best = child;
+				if (!before(h, _heap[best]))
+					break;
+				place(i, _heap[best]);
+				i = best;
+			}
+			place(i, h);
+		}
+
+		void removeAt(size_type i) {
+			handle_type h = _heap[i];
+			handle_type moved = _heap.back();
+			_heap.pop_back();
+			_position[h] = npos();
+			_values[h] = T();
+			_free.push_back(h);
+			if (i == _heap.size())
+				return;
+			place(i, moved);
+			siftDown(i);
+			siftUp(_position[moved]);
+		}
+
+	public:
+		explicit IndexedPriorityQueue(const Compare &compare = Compare()) : _comp(compare) {};
+
+		bool empty() const { return _heap.empty(); };
+		size_type size() const { return _heap.size(); };
+		const_reference top() const { return _values[_heap.front()]; };
+		handle_type top_handle() const { return _heap.front(); };
+		bool contains(handle_type h) const { return h < _position.size() && _position[h] != npos(); };
+		const_reference value(handle_type h) const { return _values[h]; };
+
+		void reserve(size_type count) {
+			_heap.reserve(count);
+			_values.reserve(count);
+			_position.reserve(count);
+		};
+
+		handle_type push(const value_type &value) {
+			handle_type h;
+			if (_free.empty()) {
+				h = _values.size();
+				_values.push_back(value);
+				try {
+					_position.push_back(npos());
+				} catch (...) {
+					_values.pop_back();
+					throw;
+				}
+			} else {
+				h = _free.back();
+				_values[h] = value;
+				_free.pop_back();
+			}
+			try {
+				_heap.push_back(h);
+			} catch (...) {
+				_values[h] = T();
+				_free.push_back(h);
+				throw;
+			}
+			_position[h] = _heap.size() - 1;
+			siftUp(_heap.size() - 1);
+			return h;
+		};
+
+		void pop() { removeAt(0); };
+
+		void erase(handle_type h) { removeAt(_position[h]); };
+
+		// Moves `h` towards the top; `value` must not compare below the current one.
+		void decrease_key(handle_type h, const value_type &value) {
+			_values[h] = value;
+			siftUp(_position[h]);
+		};
+
+		// Replaces the value of `h` and moves it in whichever direction is needed.
+		void update(handle_type h, const value_type &value) {
+			bool up = _comp(_values[h], value);
+			_values[h] = value;
+			if (up)
+				siftUp(_position[h]);
+			else
+				siftDown(_position[h]);
+		};
+
+		void clear() {
+			_heap.clear();
+			_values.clear();
+			_position.clear();
+			_free.clear();
+		};
+	};
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <pthread.h>
+
+namespace ft {
+	// A unit of deferred cleanup; run() does the work and frees the job itself.
+	struct reclaim_job {
+		reclaim_job	*next;
+		void		(*run)(reclaim_job *);
+
+		explicit reclaim_job(void (*r)(reclaim_job *)) : next(0), run(r) {}
+	};
+
+	// One process-wide thread that runs reclaim_jobs in submission order, so a
+	// container can hand off a detached node graph for the cost of a lock and a
+	// list push. The thread starts on first use. At exit the queue is drained and
+	// the thread joined; jobs deferred after that, or when no thread can be
+	// started, run on the caller.
+	class background_reclaimer {
+		pthread_mutex_t	_lock;
+		pthread_cond_t	_wake;
+		pthread_cond_t	_idle;
+		reclaim_job		*_head;
+		reclaim_job		*_tail;
+		pthread_t		_thread;
+		bool			_started;
+		bool			_busy;
+		bool			_stop;
+
+		background_reclaimer() : _head(0), _tail(0), _started(false), _busy(false), _stop(false) {
+			pthread_mutex_init(&_lock, 0);
+			pthread_cond_init(&_wake, 0);
+			pthread_cond_init(&_idle, 0);
+		}
+
+		background_reclaimer(const background_reclaimer &);
+		background_reclaimer &operator=(const background_reclaimer &);
+
+		// Plain flag rather than a member: it must stay readable once the instance is gone.
+		static bool &finished() {
+			static bool done = false;
+			return done;
+		}
+
+		static background_reclaimer &instance() {
+			static background_reclaimer reclaimer;
+			return reclaimer;
+		}
+
+		static void runAll(reclaim_job *job) {
+			while (job) {
+				reclaim_job *next = job->next;
+				job->run(job);
+				job = next;
+			}
+		}
+
+		static void *reclaimerMain(void *arg) {
+			background_reclaimer *self = static_cast<background_reclaimer *>(arg);
+			pthread_mutex_lock(&self->_lock);
+			for (;;) {
+				while (!self->_head && !self->_stop)
+					pthread_cond_wait(&self->_wake, &self->_lock);
+				if (!self->_head)
+					break;
+				reclaim_job *batch = self->_head;
+				self->_head = self->_tail = 0;
+				self->_busy = true;
+				pthread_mutex_unlock(&self->_lock);
+				runAll(batch);
+				pthread_mutex_lock(&self->_lock);
+				self->_busy = false;
+				pthread_cond_broadcast(&self->_idle);
+			}
+			pthread_mutex_unlock(&self->_lock);
+			return 0;
+		}
+
+		bool enqueue(reclaim_job *job) {
+			pthread_mutex_lock(&_lock);
+			if (!_started && !_stop)
+				_started = pthread_create(&_thread, 0, reclaimerMain, this) == 0;
+			bool queued = _started && !_stop;
+			if (queued) {
+				job->next = 0;
+				if (_tail)
+					_tail->next = job;
+				else
+					_head = job;
+				_tail = job;
+				pthread_cond_signal(&_wake);
+			}
+			pthread_mutex_unlock(&_lock);
+			return queued;
+		}
+
+	public:
+		~background_reclaimer() {
+			pthread_mutex_lock(&_lock);
+			finished() = true;
+			_stop = true;
+			pthread_cond_signal(&_wake);
+			pthread_mutex_unlock(&_lock);
+			if (_started)
+				pthread_join(_thread, 0);
+			runAll(_head);
+			pthread_cond_destroy(&_idle);
+			pthread_cond_destroy(&_wake);
+			pthread_mutex_destroy(&_lock);
+		}
+
+		// Runs job on the reclaimer thread, or right here if that is not possible.
+		static void defer(reclaim_job *job) {
+			if (finished() || !instance().enqueue(job)) {
+				job->next = 0;
+				runAll(job);
+			}
+		}
+
+		// Blocks until every job deferred so far has run.
+		static void wait_idle() {
+			if (finished())
+				return;
+			background_reclaimer &r = instance();
+			pthread_mutex_lock(&r._lock);
+			while (r._head || r._busy)
+				pthread_cond_wait(&r._idle, &r._lock);
+			pthread_mutex_unlock(&r._lock);
+		}
+	};
+}
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <memory>
+#include <new>
+
+#include "Utility.hpp"
+
+namespace ft {
+	// Concurrency modes for RingQueue.
+	struct ring_single {};	// one thread, no atomics
+	struct ring_spsc {};	// one producer thread and one consumer thread
+	struct ring_mpmc {};	// any number of producers and consumers
+
+	// Fixed storage shared by every RingQueue mode: `capacity` is rounded up to a
+	// power of two so that positions wrap with a mask instead of a division.
+	template <class T, class A>
+	class ring_storage {
+	public:
+		typedef T				value_type;
+		typedef A				allocator_type;
+		typedef std::size_t		size_type;
+
+	protected:
+		allocator_type	_allocator;
+		T				*_buffer;
+		size_type		_mask;
+
+		static size_type roundCapacity(size_type capacity) {
+			size_type n = 1;
+			while (n < capacity)
+				n <<= 1;
+			return n;
+		}
+
+		ring_storage(size_type capacity, const A& alloc)
+			: _allocator(alloc), _buffer(0), _mask(roundCapacity(capacity) - 1) {
+			_buffer = _allocator.allocate(_mask + 1);
+		}
+
+		~ring_storage() { _allocator.deallocate(_buffer, _mask + 1); }
+
+		T *slot(size_type pos) const { return _buffer + (pos & _mask); }
+
+	private:
+		ring_storage(const ring_storage &);
+		ring_storage &operator=(const ring_storage &);
+
+	public:
+		size_type capacity() const { return _mask + 1; }
+		allocator_type get_allocator() const { return _allocator; }
+	};
+
+	// Bounded FIFO over a ring buffer that never allocates after construction.
+	// push/pop return false instead of blocking when the queue is full/empty, and
+	// push_n/pop_n move up to `count` elements, returning how many were moved.
+	template < class T, class Mode = ring_single, class A = std::allocator<T> >
+	class RingQueue;
+
+	template <class T, class A>
+	class RingQueue<T, ring_single, A> : public ring_storage<T, A> {
+		typedef ring_storage<T, A>	base;
+	public:
+		typedef typename base::size_type	size_type;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+
+	private:
+		size_type	_head;
+		size_type	_tail;
+
+	public:
+		explicit RingQueue(size_type capacity, const A& alloc = A()) : base(capacity, alloc), _head(0), _tail(0) {}
+
+		~RingQueue() {
+			for (; _head != _tail; ++_head)
+				this->_allocator.destroy(this->slot(_head));
+		}
+
+		bool empty() const { return _head == _tail; }
+		bool full() const { return _tail - _head > this->_mask; }
+		size_type size() const { return _tail - _head; }
+		reference front() { return *this->slot(_head); }
+		const_reference front() const { return *this->slot(_head); }
+		reference back() { return *this->slot(_tail - 1); }
+		const_reference back() const { return *this->slot(_tail - 1); }
+
+		bool push(const_reference value) {
+			if (full())
+				return false;
+			this->_allocator.construct(this->slot(_tail), value);
+			++_tail;
+			return true;
+		}
+
+#if __cplusplus >= 201103L
+		bool push(T&& value) { return emplace(std::move(value)); }
+
+		template <class... Args>
+		bool emplace(Args&&... args) {
+			if (full())
+				return false;
+			std::allocator_traits<A>::construct(this->_allocator, this->slot(_tail), std::forward<Args>(args)...);
+			++_tail;
+			return true;
+		}
+#endif
+
+		bool pop(reference out) {
+			if (empty())
+				return false;
+			out = FT_MOVE(*this->slot(_head));
+			this->_allocator.destroy(this->slot(_head));
+			++_head;
+			return true;
+		}
+
+		void pop() {
+			this->_allocator.destroy(this->slot(_head));
+			++_head;
+		}
+
+		template <class InputIt>
+		size_type push_n(InputIt first, size_type count) {
+			size_type n = 0;
+			for (; n < count && push(*first); ++n)
+				++first;
+			return n;
+		}
+
+		template <class OutputIt>
+		size_type pop_n(OutputIt out, size_type count) {
+			size_type n = 0;
+			for (; n < count && !empty(); ++n, ++out) {
+				*out = FT_MOVE(*this->slot(_head));
+				pop();
+			}
+			return n;
+		}
+	};
+
+	// Lamport queue: the producer owns _tail and the consumer owns _head. Each side
+	// keeps a private copy of the other's index and only re-reads the shared one
+	// when the copy says full/empty, so the cache lines rarely bounce.
+	template <class T, class A>
+	class RingQueue<T, ring_spsc, A> : public ring_storage<T, A> {
+		typedef ring_storage<T, A>	base;
+	public:
+		typedef typename base::size_type	size_type;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+
+	private:
+		size_type	_head __attribute__((aligned(64)));
+		size_type	_cached_tail;
+		size_type	_tail __attribute__((aligned(64)));
+		size_type	_cached_head;
+
+		// Producer side: number of free slots, refreshed from _head when needed.
+		size_type writable(size_type wanted) {
+			size_type free = this->_mask + 1 - (_tail - _cached_head);
+			if (free < wanted) {
+				_cached_head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+				free = this->_mask + 1 - (_tail - _cached_head);
+			}
+			return free;
+		}
+
+		// Consumer side: number of filled slots, refreshed from _tail when needed.
+		size_type readable(size_type wanted) {
+			size_type filled = _cached_tail - _head;
+			if (filled < wanted) {
+				_cached_tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+				filled = _cached_tail - _head;
+			}
+			return filled;
+		}
+
+	public:
+		explicit RingQueue(size_type capacity, const A& alloc = A())
+			: base(capacity, alloc), _head(0), _cached_tail(0), _tail(0), _cached_head(0) {}
+
+		~RingQueue() {
+			for (; _head != _tail; ++_head)
+				this->_allocator.destroy(this->slot(_head));
+		}
+
+		bool empty() const { return __atomic_load_n(&_head, __ATOMIC_ACQUIRE) == __atomic_load_n(&_tail, __ATOMIC_ACQUIRE); }
+		size_type size() const { return __atomic_load_n(&_tail, __ATOMIC_ACQUIRE) - __atomic_load_n(&_head, __ATOMIC_ACQUIRE); }
+
+		bool push(const_reference value) {
+			if (!writable(1))
+				return false;
+			this->_allocator.construct(this->slot(_tail), value);
+			__atomic_store_n(&_tail, _tail + 1, __ATOMIC_RELEASE);
+			return true;
+		}
+
+#if __cplusplus >= 201103L
+		bool push(T&& value) { return emplace(std::move(value)); }
+
+		template <class... Args>
+		bool emplace(Args&&... args) {
+			if (!writable(1))
+				return false;
+			std::allocator_traits<A>::construct(this->_allocator, this->slot(_tail), std::forward<Args>(args)...);
+			__atomic_store_n(&_tail, _tail + 1, __ATOMIC_RELEASE);
+			return true;
+		}
+#endif
+
+		bool pop(reference out) {
+			if (!readable(1))
+				return false;
+			T *p = this->slot(_head);
+			out = FT_MOVE(*p);
+			this->_allocator.destroy(p);
+			__atomic_store_n(&_head, _head + 1, __ATOMIC_RELEASE);
+			return true;
+		}
+
+		// The whole batch is published with a single store of _tail.
+		template <class InputIt>
+		size_type push_n(InputIt first, size_type count) {
+			count = std::min(count, writable(count));
+			size_type n = 0;
+			try {
+				for (; n < count; ++n, ++first)
+					this->_allocator.construct(this->slot(_tail + n), *first);
+			} catch (...) {
+				__atomic_store_n(&_tail, _tail + n, __ATOMIC_RELEASE);
+				throw;
+			}
+			__atomic_store_n(&_tail, _tail + n, __ATOMIC_RELEASE);
+			return n;
+		}
+
+		template <class OutputIt>
+		size_type pop_n(OutputIt out, size_type count) {
+			count = std::min(count, readable(count));
+			size_type n = 0;
+			try {
+				for (; n < count; ++n, ++out) {
+					T *p = this->slot(_head + n);
+					*out = FT_MOVE(*p);
+					this->_allocator.destroy(p);
+				}
+			} catch (...) {
+				__atomic_store_n(&_head, _head + n, __ATOMIC_RELEASE);
+				throw;
+			}
+			__atomic_store_n(&_head, _head + n, __ATOMIC_RELEASE);
+			return n;
+		}
+	};
+
+	// Vyukov bounded MPMC queue: every slot carries a sequence number telling
+	// whether it is ready to be written (seq == pos) or read (seq == pos + 1) for
+	// the lap that `pos` belongs to. Producers and consumers claim positions with
+	// a CAS on their own index and never touch the other side's counter. If
+	// building an element throws after its position was claimed, the slot is
+	// published as a skip entry that pop passes over; until then it still counts
+	// towards size().
+	template <class T, class A>
+	class RingQueue<T, ring_mpmc, A> : public ring_storage<T, A> {
+		typedef ring_storage<T, A>									base;
+		typedef typename A::template rebind<std::size_t>::other	allocator_rebind_seq;
+		typedef typename A::template rebind<bool>::other			allocator_rebind_skip;
+	public:
+		typedef typename base::size_type	size_type;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+
+	private:
+		allocator_rebind_seq	_allocator_rebind_seq;
+		allocator_rebind_skip	_allocator_rebind_skip;
+		size_type				*_seq;
+		bool					*_skip;
+		size_type				_enqueue __attribute__((aligned(64)));
+		size_type				_dequeue __attribute__((aligned(64)));
+
+		// Claims the next writable position, or returns false when the queue is full.
+		bool claimPush(size_type &pos) {
+			pos = __atomic_load_n(&_enqueue, __ATOMIC_RELAXED);
+			for (;;) {
+				size_type seq = __atomic_load_n(_seq + (pos & this->_mask), __ATOMIC_ACQUIRE);
+				std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+				if (diff == 0) {
+					if (__atomic_compare_exchange_n(&_enqueue, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+						return true;
+				} else if (diff < 0)
+					return false;
+				else
+					pos = __atomic_load_n(&_enqueue, __ATOMIC_RELAXED);
+			}
+		}
+
+		bool claimPop(size_type &pos) {
+			pos = __atomic_load_n(&_dequeue, __ATOMIC_RELAXED);
+			for (;;) {
+				size_type seq = __atomic_load_n(_seq + (pos & this->_mask), __ATOMIC_ACQUIRE);
+				std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+				if (diff == 0) {
+					if (__atomic_compare_exchange_n(&_dequeue, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+						return true;
+				} else if (diff < 0)
+					return false;
+				else
+					pos = __atomic_load_n(&_dequeue, __ATOMIC_RELAXED);
+			}
+		}
+
+		// Claims the next position that holds an element, releasing the skip
+		// entries in front of it.
+		bool claimValue(size_type &pos) {
+			while (claimPop(pos)) {
+				bool *skip = _skip + (pos & this->_mask);
+				if (!*skip)
+					return true;
+				*skip = false;
+				publishPop(pos);
+			}
+			return false;
+		}
+
+		void publishPush(size_type pos) { __atomic_store_n(_seq + (pos & this->_mask), pos + 1, __ATOMIC_RELEASE); }
+		void publishPop(size_type pos) { __atomic_store_n(_seq + (pos & this->_mask), pos + this->_mask + 1, __ATOMIC_RELEASE); }
+
+		// A claimed slot must be published, so one whose element could not be
+		// built is published empty.
+		void publishSkip(size_type pos) {
+			_skip[pos & this->_mask] = true;
+			publishPush(pos);
+		}
+
+		// Moves the element at a claimed position straight into dst and frees the
+		// slot. A claimed slot must be published, so if the assignment throws the
+		// element is dropped.
+		template <class Out>
+		void take(size_type pos, Out &dst) {
+			T *p = this->slot(pos);
+			try {
+				dst = FT_MOVE(*p);
+			} catch (...) {
+				this->_allocator.destroy(p);
+				publishPop(pos);
+				throw;
+			}
+			this->_allocator.destroy(p);
+			publishPop(pos);
+		}
+
+	public:
+		explicit RingQueue(size_type capacity, const A& alloc = A())
+			: base(capacity, alloc), _allocator_rebind_seq(alloc), _allocator_rebind_skip(alloc), _seq(0), _skip(0),
+			  _enqueue(0), _dequeue(0) {
+			_seq = _allocator_rebind_seq.allocate(this->_mask + 1);
+			try {
+				_skip = _allocator_rebind_skip.allocate(this->_mask + 1);
+			} catch (...) {
+				_allocator_rebind_seq.deallocate(_seq, this->_mask + 1);
+				throw;
+			}
+			for (size_type i = 0; i <= this->_mask; ++i) {
+				_seq[i] = i;
+				_skip[i] = false;
+			}
+		}
+
+		~RingQueue() {
+			for (; _dequeue != _enqueue; ++_dequeue)
+				if (!_skip[_dequeue & this->_mask])
+					this->_allocator.destroy(this->slot(_dequeue));
+			_allocator_rebind_skip.deallocate(_skip, this->_mask + 1);
+			_allocator_rebind_seq.deallocate(_seq, this->_mask + 1);
+		}
+
+		bool empty() const { return size() == 0; }
+		size_type size() const {
+			size_type tail = __atomic_load_n(&_enqueue, __ATOMIC_ACQUIRE);
+			size_type head = __atomic_load_n(&_dequeue, __ATOMIC_ACQUIRE);
+			return tail > head ? tail - head : 0;
+		}
+
+		bool push(const_reference value) {
+			size_type pos;
+			if (!claimPush(pos))
+				return false;
+			try {
+				this->_allocator.construct(this->slot(pos), value);
+			} catch (...) {
+				publishSkip(pos);
+				throw;
+			}
+			publishPush(pos);
+			return true;
+		}
+
+#if __cplusplus >= 201103L
+		bool push(T&& value) { return emplace(std::move(value)); }
+
+		template <class... Args>
+		bool emplace(Args&&... args) {
+			size_type pos;
+			if (!claimPush(pos))
+				return false;
+			try {
+				std::allocator_traits<A>::construct(this->_allocator, this->slot(pos), std::forward<Args>(args)...);
+			} catch (...) {
+				publishSkip(pos);
+				throw;
+			}
+			publishPush(pos);
+			return true;
+		}
+#endif
+
+		bool pop(reference out) {
+			size_type pos;
+			if (!claimValue(pos))
+				return false;
+			take(pos, out);
+			return true;
+		}
+
+		template <class InputIt>
+		size_type push_n(InputIt first, size_type count) {
+			size_type n = 0;
+			for (; n < count && push(*first); ++n)
+				++first;
+			return n;
+		}
+
+		template <class OutputIt>
+		size_type pop_n(OutputIt out, size_type count) {
+			size_type n = 0;
+			size_type pos;
+			for (; n < count && claimValue(pos); ++n, ++out)
+				take(pos, *out);
+			return n;
+		}
+	};
+}
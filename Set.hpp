@@ -3,8 +3,17 @@
 #include "Utility.hpp"
 #include "Iterator.hpp"
 #include "Node.hpp"
+#include "Stats.hpp"
 
 namespace ft {
+// Red-black tree set. Iterators and references stay valid until their
+// element is erased, with one exception: a set that has never held an element
+// points at a tree shared by every empty set of its value type, and its first
+// insert (or assign_sorted) gives it a tree of its own. An end() taken before
+// that no longer compares equal to end(). clear() and erasing every element
+// keep the tree, so end() stays valid across them. operator= installs a new
+// tree, so it invalidates end() too. FT_STATS builds give each set its own tree
+// from the start.
 template <class Key, class Compare = std::less<Key>, class A = std::allocator<Key > >
 class Set {
 public:
@@ -31,49 +40,49 @@ private:
 	allocator_rebind_node	_allocator_rebind_node;
 	Compare					_comp;
 	Tree<value_type >*		_tree;
+	bool					_deferred_teardown;
 public:
 
-	Set()
-	{
-		_tree = _allocator_rebind_tree.allocate(sizeof(Tree<value_type>));
-		_allocator_rebind_tree.construct(_tree);
-	}
+	Set() : _deferred_teardown(false)
+		{ initTree(); }
 
 	explicit Set(const Compare& comp, const A& alloc = A())
-	: _allocator(alloc), _comp(comp)
+	: _allocator(alloc), _allocator_rebind_tree(alloc), _allocator_rebind_node(alloc), _comp(comp), _deferred_teardown(false)
 	{
-		_tree = _allocator_rebind_tree.allocate(sizeof(Tree<value_type>));
-		_allocator_rebind_tree.construct(_tree);
+		initTree();
 	}
 
 	template< class InputIt >
 	Set(InputIt first, InputIt last, const Compare& comp = Compare(), const A& alloc = A())
-		 	: _allocator(alloc), _comp(comp)
+		 	: _allocator(alloc), _allocator_rebind_tree(alloc), _allocator_rebind_node(alloc), _comp(comp), _deferred_teardown(false)
 		 {
-		_tree = _allocator_rebind_tree.allocate(sizeof(Tree<value_type>));
-		_allocator_rebind_tree.construct(_tree);
+		initTree();
 		for (; first != last; first++)
 			insert(*first);
 	}
 
 	Set(const Set& other)
+	: _allocator(other._allocator), _allocator_rebind_tree(other._allocator),
+	  _allocator_rebind_node(other._allocator), _comp(other._comp), _deferred_teardown(false)
 	{
-		_tree = _allocator_rebind_tree.allocate(sizeof(Tree<value_type>));
-		_allocator_rebind_tree.construct(_tree, *(other._tree));
+		initTree();
 		fillTree(other._tree->root);
 	}
 
 
+	// Builds the copy aside and swaps it in; the old contents go with the temporary.
 	Set& operator=( const Set& other )
 	{
 		if (this == &other)
 			return *this;
+		Set copy(other._comp, other._allocator);
+#ifdef FT_STATS
+		copy._tree->stats = _tree->stats;
+#endif
+		copy._deferred_teardown = _deferred_teardown;
+		copy.fillTree(other._tree->root);
+		swap(copy);
 		_comp = other._comp;
-		_allocator = other._allocator;
-		clearSet();
-		_tree = _allocator_rebind_tree.allocate(sizeof(Tree<value_type>));
-		_allocator_rebind_tree.construct(_tree, *other._tree);
-		fillTree(other._tree->root);
 		return *this;
 	}
 
@@ -92,12 +101,34 @@ public:
 	bool empty() const { return size() == 0; }
 	size_type size() const { return _tree->m_size; }
 	size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(Node_<value_type>); }
+	// Bytes held by the set, its tree header and every node. Each node is two
+	// blocks from the allocator, the links and the value; the sentinel lives in the header.
+	size_type memory_usage() const
+	{
+		if (_tree == emptyTree())
+			return sizeof(*this);
+		return sizeof(*this) + sizeof(Tree<value_type>)
+			   + size() * (sizeof(Node_<value_type>) + sizeof(value_type));
+	}
+	// When set, clear() and the destructor hand a large tree to ft::background_reclaimer
+	// instead of freeing it inline. Belongs to this instance: not copied or swapped.
+	// Ignored unless A is an ft::is_thread_safe_allocator; deferred_teardown() tells.
+	void set_deferred_teardown(bool deferred) { _deferred_teardown = deferred && ft::is_thread_safe_allocator<A>::value; }
+	bool deferred_teardown() const { return _deferred_teardown; }
+#ifdef FT_STATS
+	ft::tree_stats stats() const
+	{
+		ft::tree_stats s = _tree->stats;
+		s.height = _tree->height();
+		return s;
+	}
+#endif
 
+	// Keeps the tree header, so a cleared set refills without allocating it again.
 	void clear()
 	{
-		clearSet();
-		_tree = _allocator_rebind_tree.allocate(sizeof(Tree<value_type>));
-		_allocator_rebind_tree.construct(_tree);
+		if (_tree != emptyTree())
+			tree_teardown<value_type, allocator_rebind_node, A>::release(_allocator_rebind_node, _allocator, *_tree, _deferred_teardown);
 	}
 
 	ft::pair<iterator, bool> insert( const value_type& value )
@@ -137,27 +168,58 @@ public:
 			insert(*first);
 	}
 
+	// [first, last) must be strictly increasing; builds a balanced tree in O(n).
+	template< class RandomIt >
+	void assign_sorted( RandomIt first, RandomIt last )
+	{
+		clear();
+		size_type n = last - first;
+		if (!n)
+			return;
+		ensureTree();
+		size_type red_level = 0;
+		for (size_type full = n + 1; full > 1; full >>= 1)
+			++red_level;
+		try {
+			buildSorted(&_tree->root, 0, first, 0, n, 0, red_level);
+		} catch (...) {
+			clear();
+			throw;
+		}
+		_tree->m_size = n;
+		_tree->sentinel.begin = _tree->getBegin();
+		_tree->sentinel.parent = _tree->getLast();
+	}
+
 	void erase( iterator pos )
 	{
-		iterator tmp = pos;
-		_tree->deleteNode(tmp.base());
+		eraseNode(pos.base());
 	}
 
 	void erase( iterator first, iterator last )
 	{
-		iterator tmp;
-
-		for (; first != last ;) {
-			tmp = first++;
-			_tree->deleteNode(tmp.base());
+		while (first != last) {
+			Node_<value_type> *z = first.base();
+			++first;
+			// A node with two children takes over its successor's value, so the
+			// successor (first, and possibly last) will live at z.
+			if (!z->left->NIL && !z->right->NIL) {
+				if (first == last)
+					last = iterator(z);
+				first = iterator(z);
+			}
+			eraseNode(z);
 		}
 	}
 
 	size_type erase( const key_type& key ) {
-		return _tree->deleteNode(find(key).base());
+		return eraseNode(find(key).base());
 	}
 
 	void swap( Set& other ) {
+		std::swap(_allocator, other._allocator);
+		std::swap(_allocator_rebind_tree, other._allocator_rebind_tree);
+		std::swap(_allocator_rebind_node, other._allocator_rebind_node);
 		std::swap(_tree, other._tree);
 	}
 
@@ -168,11 +230,13 @@ public:
 	iterator find( const Key& key ) {
 		Node_<value_type> *current = _tree->root;
 
+		FT_STAT(++_tree->stats.lookups);
 		while (!current->NIL) {
+			FT_STAT(++_tree->stats.comparisons);
 			if (key == *current->pair)
 				return (current);
-			else
-				current = _comp(key, *current->pair) ? current->left : current->right;
+			FT_STAT(++_tree->stats.comparisons);
+			current = _comp(key, *current->pair) ? current->left : current->right;
 		}
 		return end();
 	}
@@ -181,11 +245,13 @@ public:
 	{
 		Node_<value_type> *current = _tree->root;
 
+		FT_STAT(++_tree->stats.lookups);
 		while (!current->NIL) {
+			FT_STAT(++_tree->stats.comparisons);
 			if (key == *current->pair)
 				return (current);
-			else
-				current = _comp(key, *current->pair) ? current->left : current->right;
+			FT_STAT(++_tree->stats.comparisons);
+			current = _comp(key, *current->pair) ? current->left : current->right;
 		}
 		return end();
 	}
@@ -194,12 +260,15 @@ public:
 	{
 		Node_<value_type> *current = _tree->root;
 
+		FT_STAT(++_tree->stats.lookups);
 		while (!current->NIL)
 		{
+			FT_STAT(++_tree->stats.comparisons);
 			if (key == *current->pair)
 				return iterator(current);
 			else
 			{
+				FT_STAT(++_tree->stats.comparisons);
 				if (_comp(key, *current->pair))
 				{
 					if (!current->left->NIL)
@@ -223,11 +292,14 @@ public:
 	{
 		Node_<value_type> *current = _tree->root;
 
+		FT_STAT(++_tree->stats.lookups);
 		while (!current->NIL)
 		{
+			FT_STAT(++_tree->stats.comparisons);
 			if (key == *current->pair)
 				return const_iterator(current);
 			else {
+				FT_STAT(++_tree->stats.comparisons);
 				if (_comp(key, *current->pair))
 				{
 					if (!current->left->NIL)
@@ -304,37 +376,97 @@ private:
 			fillTree(t->right);
 	}
 
-	void clearTree(Node_<value_type> *tmp)
+	size_type eraseNode(Node_<value_type> *z)
 	{
-		if (tmp->NIL)
+		Node_<value_type> *y = _tree->deleteNode(z);
+		if (!y)
+			return 0;
+		Tree<value_type>::destroyNode(_allocator_rebind_node, _allocator, y);
+		return 1;
+	}
+
+	// Shared by every empty set of this value type until its first insert. Only
+	// read through, and never destroyed, so sets with static storage can use it at exit.
+	static Tree<value_type> *emptyTree()
+	{
+		static Tree<value_type> *empty = new Tree<value_type>();
+		return empty;
+	}
+
+	// Counters live in the tree, so instrumented builds give each set its own from the start.
+	void initTree()
+	{
+#ifdef FT_STATS
+		_tree = 0;
+		ensureTree();
+#else
+		_tree = emptyTree();
+#endif
+	}
+
+	void ensureTree()
+	{
+		if (_tree && _tree != emptyTree())
 			return;
-		if (!tmp->left->NIL) clearTree(tmp->left);
-		if (!tmp->right->NIL) clearTree(tmp->right);
-		_allocator_rebind_node.destroy(tmp);
-		_allocator_rebind_node.deallocate(tmp, sizeof(Node_<value_type>));
+		Tree<value_type> *tree = _allocator_rebind_tree.allocate(1);
+		try {
+			_allocator_rebind_tree.construct(tree);
+		} catch (...) {
+			_allocator_rebind_tree.deallocate(tree, 1);
+			throw;
+		}
+		FT_STAT(tree->stats.allocated(sizeof(Tree<value_type>)));
+		_tree = tree;
 	}
 
 	void clearSet()
 	{
-		clearTree(_tree->root);
+		if (_tree == emptyTree())
+			return;
+		clear();
 		_allocator_rebind_tree.destroy(_tree);
-		_allocator_rebind_tree.deallocate(_tree, sizeof(Tree<value_type>));
+		_allocator_rebind_tree.deallocate(_tree, 1);
+	}
+
+	template< class RandomIt >
+	void buildSorted(Node_<value_type> **slot, Node_<value_type> *parent, RandomIt first,
+					 size_type lo, size_type hi, size_type level, size_type red_level)
+	{
+		if (lo == hi)
+			return;
+		size_type mid = lo + (hi - lo) / 2;
+		Node_<value_type> *x = Tree<value_type>::createNode(_allocator_rebind_node, _allocator, first[mid]);
+		FT_STAT(_tree->stats.allocated(sizeof(Node_<value_type>) + sizeof(value_type)));
+		x->parent = parent;
+		x->left = &_tree->sentinel;
+		x->right = &_tree->sentinel;
+		x->color = (level == red_level);
+		*slot = x;
+		buildSorted(&x->left, x, first, lo, mid, level + 1, red_level);
+		buildSorted(&x->right, x, first, mid + 1, hi, level + 1, red_level);
 	}
 
 	ft::pair<iterator, bool> insertNode(Node_<value_type> *hint, const value_type& value)
 	{
 		Node_<value_type> *current, *parent, *x;
 
+		if (_tree == emptyTree()) {
+			ensureTree();
+			hint = _tree->root;
+		}
 		current = hint;
 		parent = 0;
+		FT_STAT(++_tree->stats.lookups);
 		while (!current->NIL)
 		{
+			FT_STAT(++_tree->stats.comparisons);
 			if (value == *current->pair) return ft::make_pair(current, false);
 			parent = current;
+			FT_STAT(++_tree->stats.comparisons);
 			current = _comp(value, *current->pair) ? current->left : current->right;
 		}
-		x = _allocator_rebind_node.allocate(sizeof(Node_<value_type>));
-		_allocator_rebind_node.construct(x, value);
+		x = Tree<value_type>::createNode(_allocator_rebind_node, _allocator, value);
+		FT_STAT(_tree->stats.allocated(sizeof(Node_<value_type>) + sizeof(value_type)));
 		x->parent = parent;
 		x->left = &_tree->sentinel;
 		x->right = &_tree->sentinel;
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <climits>
+#include <cstring>
+#include <stdint.h>
+#if defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+#include "Utility.hpp"
+
+// Contiguous-array kernels behind Vector's comparisons and ft::find/count/min_max.
+// With __AVX2__ or __SSE2__ integral and floating elements are compared a whole
+// register at a time; everything else, and builds without either, use scalar loops.
+
+namespace ft {
+	struct simd_scalar_tag {};
+	struct simd_integral_tag {};
+	struct simd_float_tag {};
+	struct simd_double_tag {};
+
+	template <class T, bool = ft::is_integral<T>::value>
+	struct simd_category { typedef simd_scalar_tag type; };
+
+	template <class T>
+	struct simd_minmax { static const bool enabled = false; };
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	template <class T>
+	struct simd_category<T, true> { typedef simd_integral_tag type; };
+	template <> struct simd_category<float, false> { typedef simd_float_tag type; };
+	template <> struct simd_category<double, false> { typedef simd_double_tag type; };
+
+# if defined(__AVX2__)
+	typedef __m256i				simd_reg;
+	static const std::size_t	simd_width = 32;
+	static const uint32_t		simd_full = 0xffffffffu;
+
+	inline simd_reg simd_load(const void *p) { return _mm256_loadu_si256(static_cast<const __m256i *>(p)); }
+	inline uint32_t simd_eq8(simd_reg a, simd_reg b) { return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+	inline uint32_t simd_eq(const float *a, const float *b)
+		{ return (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b), _CMP_EQ_OQ)); }
+	inline uint32_t simd_eq(const double *a, const double *b)
+		{ return (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b), _CMP_EQ_OQ)); }
+# else
+	typedef __m128i				simd_reg;
+	static const std::size_t	simd_width = 16;
+	static const uint32_t		simd_full = 0xffffu;
+
+	inline simd_reg simd_load(const void *p) { return _mm_loadu_si128(static_cast<const __m128i *>(p)); }
+	inline uint32_t simd_eq8(simd_reg a, simd_reg b) { return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+	inline uint32_t simd_eq(const float *a, const float *b)
+		{ return (uint32_t)_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))); }
+	inline uint32_t simd_eq(const double *a, const double *b)
+		{ return (uint32_t)_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a), _mm_loadu_pd(b))); }
+# endif
+
+	// Reduces a byte-equality mask to one bit per element, set at the element's
+	// first byte when all of its bytes matched.
+	template <std::size_t Size> inline uint32_t simd_element_mask(uint32_t m);
+	template <> inline uint32_t simd_element_mask<1>(uint32_t m) { return m; }
+	template <> inline uint32_t simd_element_mask<2>(uint32_t m) { return m & (m >> 1) & 0x55555555u; }
+	template <> inline uint32_t simd_element_mask<4>(uint32_t m) {
+		m &= m >> 1;
+		m &= m >> 2;
+		return m & 0x11111111u;
+	}
+	template <> inline uint32_t simd_element_mask<8>(uint32_t m) {
+		m &= m >> 1;
+		m &= m >> 2;
+		m &= m >> 4;
+		return m & 0x01010101u;
+	}
+
+	template <class T>
+	std::size_t simd_mismatch(const T *a, const T *b, std::size_t n, simd_integral_tag) {
+		std::size_t i = 0;
+		for (; i + simd_width / sizeof(T) <= n; i += simd_width / sizeof(T)) {
+			uint32_t m = simd_eq8(simd_load(a + i), simd_load(b + i));
+			if (m != simd_full)
+				return i + __builtin_ctz(~m) / sizeof(T);
+		}
+		for (; i < n && a[i] == b[i]; ++i) {}
+		return i;
+	}
+
+	template <class T>
+	std::size_t simd_mismatch_floating(const T *a, const T *b, std::size_t n) {
+		const std::size_t step = simd_width / sizeof(T);
+		const uint32_t full = (1u << step) - 1;
+		std::size_t i = 0;
+		for (; i + step <= n; i += step) {
+			uint32_t m = simd_eq(a + i, b + i);
+			if (m != full)
+				return i + __builtin_ctz(~m);
+		}
+		for (; i < n && a[i] == b[i]; ++i) {}
+		return i;
+	}
+
+	inline std::size_t simd_mismatch(const float *a, const float *b, std::size_t n, simd_float_tag)
+		{ return simd_mismatch_floating(a, b, n); }
+	inline std::size_t simd_mismatch(const double *a, const double *b, std::size_t n, simd_double_tag)
+		{ return simd_mismatch_floating(a, b, n); }
+
+	// Element-wise equality mask of `p[0..step)` against a register-wide splat.
+	template <class T>
+	uint32_t simd_match(const T *p, const T *splat, simd_integral_tag)
+		{ return simd_element_mask<sizeof(T)>(simd_eq8(simd_load(p), simd_load(splat))); }
+	inline uint32_t simd_match(const float *p, const float *splat, simd_float_tag) { return simd_eq(p, splat); }
+	inline uint32_t simd_match(const double *p, const double *splat, simd_double_tag) { return simd_eq(p, splat); }
+
+	// Bit distance between consecutive elements in a simd_match mask.
+	template <class T>
+	std::size_t simd_stride(simd_integral_tag) { return sizeof(T); }
+	template <class T>
+	std::size_t simd_stride(simd_float_tag) { return 1; }
+	template <class T>
+	std::size_t simd_stride(simd_double_tag) { return 1; }
+
+	template <class T, class Tag>
+	std::size_t simd_find(const T *p, std::size_t n, const T &value, Tag tag) {
+		const std::size_t step = simd_width / sizeof(T);
+		T splat[simd_width / sizeof(T)];
+		std::fill(splat, splat + step, value);
+		std::size_t i = 0;
+		for (; i + step <= n; i += step) {
+			uint32_t m = simd_match(p + i, splat, tag);
+			if (m)
+				return i + __builtin_ctz(m) / simd_stride<T>(tag);
+		}
+		for (; i < n && !(p[i] == value); ++i) {}
+		return i;
+	}
+
+	template <class T, class Tag>
+	std::size_t simd_count(const T *p, std::size_t n, const T &value, Tag tag) {
+		const std::size_t step = simd_width / sizeof(T);
+		T splat[simd_width / sizeof(T)];
+		std::fill(splat, splat + step, value);
+		std::size_t count = 0;
+		std::size_t i = 0;
+		for (; i + step <= n; i += step)
+			count += __builtin_popcount(simd_match(p + i, splat, tag));
+		for (; i < n; ++i)
+			count += p[i] == value;
+		return count;
+	}
+
+	// Register-wide min/max for the element types that have them: 8/16/32-bit
+	// integers and floating point with AVX2, 16-bit signed, 8-bit unsigned and
+	// floating point with SSE2.
+# if defined(__AVX2__)
+#  define FT_SIMD_MINMAX_INT(T, suffix) \
+	template <> struct simd_minmax<T> { \
+		static const bool enabled = true; \
+		typedef __m256i reg; \
+		static reg load(const T *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); } \
+		static void store(T *p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); } \
+		static reg min(reg a, reg b) { return _mm256_min_##suffix(a, b); } \
+		static reg max(reg a, reg b) { return _mm256_max_##suffix(a, b); } \
+	};
+#  define FT_SIMD_MINMAX_FLOAT(T, type, suffix) \
+	template <> struct simd_minmax<T> { \
+		static const bool enabled = true; \
+		typedef type reg; \
+		static reg load(const T *p) { return _mm256_loadu_##suffix(p); } \
+		static void store(T *p, reg v) { _mm256_storeu_##suffix(p, v); } \
+		static reg min(reg a, reg b) { return _mm256_min_##suffix(a, b); } \
+		static reg max(reg a, reg b) { return _mm256_max_##suffix(a, b); } \
+	};
+	FT_SIMD_MINMAX_INT(signed char, epi8)
+	FT_SIMD_MINMAX_INT(unsigned char, epu8)
+#  if CHAR_MIN < 0
+	FT_SIMD_MINMAX_INT(char, epi8)
+#  else
+	FT_SIMD_MINMAX_INT(char, epu8)
+#  endif
+	FT_SIMD_MINMAX_INT(short, epi16)
+	FT_SIMD_MINMAX_INT(unsigned short, epu16)
+	FT_SIMD_MINMAX_INT(int, epi32)
+	FT_SIMD_MINMAX_INT(unsigned int, epu32)
+	FT_SIMD_MINMAX_FLOAT(float, __m256, ps)
+	FT_SIMD_MINMAX_FLOAT(double, __m256d, pd)
+# else
+#  define FT_SIMD_MINMAX_INT(T, suffix) \
+	template <> struct simd_minmax<T> { \
+		static const bool enabled = true; \
+		typedef __m128i reg; \
+		static reg load(const T *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); } \
+		static void store(T *p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); } \
+		static reg min(reg a, reg b) { return _mm_min_##suffix(a, b); } \
+		static reg max(reg a, reg b) { return _mm_max_##suffix(a, b); } \
+	};
+#  define FT_SIMD_MINMAX_FLOAT(T, type, suffix) \
+	template <> struct simd_minmax<T> { \
+		static const bool enabled = true; \
+		typedef type reg; \
+		static reg load(const T *p) { return _mm_loadu_##suffix(p); } \
+		static void store(T *p, reg v) { _mm_storeu_##suffix(p, v); } \
+		static reg min(reg a, reg b) { return _mm_min_##suffix(a, b); } \
+		static reg max(reg a, reg b) { return _mm_max_##suffix(a, b); } \
+	};
+	FT_SIMD_MINMAX_INT(unsigned char, epu8)
+#  if CHAR_MIN == 0
+	FT_SIMD_MINMAX_INT(char, epu8)
+#  endif
+	FT_SIMD_MINMAX_INT(short, epi16)
+	FT_SIMD_MINMAX_FLOAT(float, __m128, ps)
+	FT_SIMD_MINMAX_FLOAT(double, __m128d, pd)
+# endif
+# undef FT_SIMD_MINMAX_INT
+# undef FT_SIMD_MINMAX_FLOAT
+
+	template <class T>
+	std::size_t simd_min_max(const T *p, std::size_t n, T &lo, T &hi, ft::integral_constant<bool, true>) {
+		typedef simd_minmax<T> ops;
+		const std::size_t step = sizeof(typename ops::reg) / sizeof(T);
+		if (n < 2 * step)
+			return 0;
+		typename ops::reg vmin = ops::load(p);
+		typename ops::reg vmax = vmin;
+		std::size_t i = step;
+		for (; i + step <= n; i += step) {
+			typename ops::reg v = ops::load(p + i);
+			vmin = ops::min(vmin, v);
+			vmax = ops::max(vmax, v);
+		}
+		T buf[sizeof(typename ops::reg) / sizeof(T)];
+		ops::store(buf, vmin);
+		lo = *std::min_element(buf, buf + step);
+		ops::store(buf, vmax);
+		hi = *std::max_element(buf, buf + step);
+		return i;
+	}
+#endif
+
+	template <class T>
+	std::size_t simd_min_max(const T *, std::size_t, T &, T &, ft::integral_constant<bool, false>) { return 0; }
+
+	template <class T>
+	std::size_t simd_mismatch(const T *a, const T *b, std::size_t n, simd_scalar_tag) {
+		std::size_t i = 0;
+		for (; i < n && a[i] == b[i]; ++i) {}
+		return i;
+	}
+
+	template <class T>
+	std::size_t simd_find(const T *p, std::size_t n, const T &value, simd_scalar_tag) {
+		std::size_t i = 0;
+		for (; i < n && !(p[i] == value); ++i) {}
+		return i;
+	}
+
+	template <class T>
+	std::size_t simd_count(const T *p, std::size_t n, const T &value, simd_scalar_tag) {
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < n; ++i)
+			count += p[i] == value;
+		return count;
+	}
+
+	// Index of the first i with !(a[i] == b[i]), or n.
+	template <class T>
+	std::size_t simd_mismatch(const T *a, const T *b, std::size_t n)
+		{ return simd_mismatch(a, b, n, typename simd_category<T>::type()); }
+
+	template <class T>
+	std::size_t simd_find(const T *p, std::size_t n, const T &value)
+		{ return simd_find(p, n, value, typename simd_category<T>::type()); }
+
+	template <class T>
+	std::size_t simd_count(const T *p, std::size_t n, const T &value)
+		{ return simd_count(p, n, value, typename simd_category<T>::type()); }
+
+	// Smallest and largest element of a non-empty array. NaNs give unspecified results.
+	template <class T>
+	ft::pair<T, T> simd_min_max(const T *p, std::size_t n) {
+		T lo = p[0];
+		T hi = p[0];
+		std::size_t i = simd_min_max(p, n, lo, hi, ft::integral_constant<bool, simd_minmax<T>::enabled>());
+		for (; i < n; ++i) {
+			if (p[i] < lo)
+				lo = p[i];
+			if (hi < p[i])
+				hi = p[i];
+		}
+		return ft::pair<T, T>(lo, hi);
+	}
+
+	// Types whose order is the order of their bytes, so memcmp compares them.
+	template <class T> struct is_byte_ordered : public integral_constant<bool, false> {};
+	template <> struct is_byte_ordered<unsigned char> : public integral_constant<bool, true> {};
+	template <> struct is_byte_ordered<bool> : public integral_constant<bool, true> {};
+#if CHAR_MIN == 0
+	template <> struct is_byte_ordered<char> : public integral_constant<bool, true> {};
+#endif
+
+	template <class T>
+	bool simd_less(const T *a, std::size_t na, const T *b, std::size_t nb, ft::integral_constant<bool, true>) {
+		std::size_t n = std::min(na, nb);
+		int cmp = n ? std::memcmp(a, b, n) : 0;
+		return cmp ? cmp < 0 : na < nb;
+	}
+
+	template <class T>
+	bool simd_less(const T *a, std::size_t na, const T *b, std::size_t nb, ft::integral_constant<bool, false>) {
+		std::size_t n = std::min(na, nb);
+		for (std::size_t i = simd_mismatch(a, b, n); i < n; i += 1 + simd_mismatch(a + i + 1, b + i + 1, n - i - 1)) {
+			if (a[i] < b[i])
+				return true;
+			if (b[i] < a[i])
+				return false;
+		}
+		return na < nb;
+	}
+
+	// Lexicographical a < b, deciding at the first pair that is not equal.
+	template <class T>
+	bool simd_less(const T *a, std::size_t na, const T *b, std::size_t nb)
+		{ return simd_less(a, na, b, nb, ft::integral_constant<bool, is_byte_ordered<T>::value>()); }
+}
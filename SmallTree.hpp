@@ -0,0 +1,608 @@
+#pragma once
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "Utility.hpp"
+#include "Iterator.hpp"
+#include "Map.hpp"
+#include "Set.hpp"
+
+namespace ft {
+	// An index into the inline array while the container is small, the wrapped
+	// tree iterator once it has been promoted. The index runs from -1 (the
+	// position before the first value) to the size, so stepping off either end
+	// never forms a pointer outside the array.
+	template <class Value, class TreeIt>
+	class small_tree_iterator {
+		template <class, class> friend class small_tree_iterator;
+
+	public:
+		typedef typename std::remove_const<Value>::type	value_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef Value&									reference;
+		typedef const Value&							const_reference;
+		typedef Value*									pointer;
+		typedef const Value*							const_pointer;
+		typedef std::bidirectional_iterator_tag			iterator_category;
+
+	private:
+		Value			*_first;
+		difference_type	_index;
+		TreeIt			_it;
+
+	public:
+		small_tree_iterator() : _first(0), _index(0), _it() {}
+		small_tree_iterator(Value *first, difference_type index) : _first(first), _index(index), _it() {}
+		explicit small_tree_iterator(const TreeIt &it) : _first(0), _index(0), _it(it) {}
+		small_tree_iterator(const small_tree_iterator &other) : _first(other._first), _index(other._index), _it(other._it) {}
+		template <class V2, class T2>
+		small_tree_iterator(const small_tree_iterator<V2, T2> &other,
+							typename ft::enable_if<std::is_convertible<V2*, Value*>::value>::type* = 0)
+			: _first(other._first), _index(other._index), _it(other._it) {}
+
+		small_tree_iterator &operator=(const small_tree_iterator &other)
+			{ _first = other._first; _index = other._index; _it = other._it; return *this; }
+
+		difference_type index() const { return _index; }
+		const TreeIt &tree_iterator() const { return _it; }
+
+		reference operator*() const { return _first ? _first[_index] : *TreeIt(_it); }
+		pointer operator->() const { return &**this; }
+
+		small_tree_iterator &operator++() {
+			if (_first)
+				++_index;
+			else
+				++_it;
+			return *this;
+		}
+		small_tree_iterator operator++(int) { small_tree_iterator tmp(*this); ++*this; return tmp; }
+		small_tree_iterator &operator--() {
+			if (_first)
+				--_index;
+			else
+				--_it;
+			return *this;
+		}
+		small_tree_iterator operator--(int) { small_tree_iterator tmp(*this); --*this; return tmp; }
+
+		template <class V2, class T2>
+		bool operator==(const small_tree_iterator<V2, T2> &other) const
+			{ return _first == other._first && (_first ? _index == other._index : _it.base() == other._it.base()); }
+		template <class V2, class T2>
+		bool operator!=(const small_tree_iterator<V2, T2> &other) const { return !(*this == other); }
+	};
+
+	// Keeps up to N values sorted in an inline array and searches them linearly;
+	// inserting the N+1th moves them all into Tree (a Map or Set, which costs no
+	// allocation while empty) and from then on every call is forwarded to it. The
+	// container goes back to the array only on clear(). While inline, insert and
+	// erase shift the array, so like a Vector they invalidate iterators at and
+	// after the position; promotion invalidates all of them.
+	template <class Value, class Key, class KeyOfValue, class Compare, class Tree, std::size_t N>
+	class SmallTree {
+	public:
+		typedef Value																	value_type;
+		typedef std::size_t																size_type;
+		typedef Tree																	tree_type;
+		typedef ft::small_tree_iterator<Value, typename Tree::iterator>					iterator;
+		typedef ft::small_tree_iterator<const Value, typename Tree::const_iterator>		const_iterator;
+
+	private:
+		typedef ft::integral_constant<bool, ft::is_trivially_relocatable<Value>::value>	relocatable;
+		typedef ft::integral_constant<bool, ft::is_integral<Key>::value
+			|| ft::is_same<Key, float>::value || ft::is_same<Key, double>::value>		cheap_compare;
+
+		Tree		_tree;
+		Compare		_comp;
+		size_type	_size;
+		bool		_promoted;
+		char		_inline[N * sizeof(Value)] __attribute__((aligned(__alignof__(Value))));
+
+		Value *slot(size_type i) { return reinterpret_cast<Value *>(_inline) + i; }
+		const Value *slot(size_type i) const { return reinterpret_cast<const Value *>(_inline) + i; }
+		const Key &key(size_type i) const { return KeyOfValue()(*slot(i)); }
+		iterator position(std::ptrdiff_t i) { return iterator(slot(0), i); }
+		const_iterator position(std::ptrdiff_t i) const { return const_iterator(slot(0), i); }
+
+		// Number of inline values ordered before k. Cheap keys are counted without
+		// branches; for the rest the scan stops at the first value not before k.
+		size_type lowerIndex(const Key &k, ft::integral_constant<bool, true>) const {
+			size_type i = 0;
+			for (size_type j = 0; j < _size; ++j)
+				i += _comp(key(j), k);
+			return i;
+		}
+
+		size_type lowerIndex(const Key &k, ft::integral_constant<bool, false>) const {
+			size_type i = 0;
+			while (i < _size && _comp(key(i), k))
+				++i;
+			return i;
+		}
+
+		size_type lowerIndex(const Key &k) const { return lowerIndex(k, cheap_compare()); }
+
+		size_type upperIndex(const Key &k) const {
+			size_type i = lowerIndex(k);
+			return i < _size && !_comp(k, key(i)) ? i + 1 : i;
+		}
+
+		size_type findIndex(const Key &k) const {
+			size_type i = lowerIndex(k);
+			return i < _size && !_comp(k, key(i)) ? i : _size;
+		}
+
+		// Shifts [i, _size) up by one and leaves slot i raw. If copying a value
+		// throws, everything from the failed slot up is dropped so the array stays
+		// sorted and contiguous.
+		void openGap(size_type i, ft::integral_constant<bool, true>)
+			{ std::memmove(static_cast<void *>(slot(i + 1)), slot(i), (_size - i) * sizeof(Value)); }
+
+		void openGap(size_type i, ft::integral_constant<bool, false>) {
+			size_type j = _size;
+			try {
+				for (; j > i; --j) {
+					::new (static_cast<void *>(slot(j))) Value(FT_MOVE_IF_NOEXCEPT(*slot(j - 1)));
+					slot(j - 1)->~Value();
+				}
+			} catch (...) {
+				dropFrom(j + 1, _size + 1);
+				_size = j;
+				throw;
+			}
+		}
+
+		// Closes the raw slot i left by an erase, with the same recovery as openGap.
+		void closeGap(size_type i, ft::integral_constant<bool, true>)
+			{ std::memmove(static_cast<void *>(slot(i)), slot(i + 1), (_size - i - 1) * sizeof(Value)); }
+
+		void closeGap(size_type i, ft::integral_constant<bool, false>) {
+			size_type j = i;
+			try {
+				for (; j + 1 < _size; ++j) {
+					::new (static_cast<void *>(slot(j))) Value(FT_MOVE_IF_NOEXCEPT(*slot(j + 1)));
+					slot(j + 1)->~Value();
+				}
+			} catch (...) {
+				dropFrom(j + 1, _size);
+				_size = j;
+				throw;
+			}
+		}
+
+		void dropFrom(size_type first, size_type last) {
+			for (; first < last; ++first)
+				slot(first)->~Value();
+		}
+
+		void destroyInline() {
+			dropFrom(0, _size);
+			_size = 0;
+		}
+
+		void promote() {
+			_tree.assign_sorted(slot(0), slot(_size));
+			destroyInline();
+			_promoted = true;
+		}
+
+		static typename Tree::iterator mutableIt(const typename Tree::const_iterator &it) {
+			typedef typename Tree::iterator::iterator_type node_pointer;
+			return typename Tree::iterator(const_cast<node_pointer>(it.base()));
+		}
+
+	public:
+		explicit SmallTree(const Compare &comp = Compare(), const typename Tree::allocator_type &alloc = typename Tree::allocator_type())
+			: _tree(comp, alloc), _comp(comp), _size(0), _promoted(false) {}
+
+		SmallTree(const SmallTree &other)
+			: _tree(other._tree), _comp(other._comp), _size(0), _promoted(other._promoted) {
+			for (; _size < other._size; ++_size)
+				::new (static_cast<void *>(slot(_size))) Value(*other.slot(_size));
+		}
+
+		SmallTree &operator=(const SmallTree &other) {
+			if (this == &other)
+				return *this;
+			clear();
+			_comp = other._comp;
+			if (other._promoted) {
+				_tree = other._tree;
+				_promoted = true;
+			}
+			for (; _size < other._size; ++_size)
+				::new (static_cast<void *>(slot(_size))) Value(*other.slot(_size));
+			return *this;
+		}
+
+		~SmallTree() { destroyInline(); }
+
+		typename Tree::allocator_type get_allocator() const { return _tree.get_allocator(); }
+		const Compare &key_comp() const { return _comp; }
+		bool promoted() const { return _promoted; }
+		size_type size() const { return _promoted ? _tree.size() : _size; }
+		size_type max_size() const { return _tree.max_size(); }
+		size_type memory_usage() const { return sizeof(*this) - sizeof(Tree) + _tree.memory_usage(); }
+
+		iterator begin() { return _promoted ? iterator(_tree.begin()) : position(0); }
+		const_iterator begin() const { return _promoted ? const_iterator(_tree.begin()) : position(0); }
+		iterator end() { return _promoted ? iterator(_tree.end()) : position(_size); }
+		const_iterator end() const { return _promoted ? const_iterator(_tree.end()) : position(_size); }
+		// ft::reverse_iterator dereferences its base directly, so these are the last
+		// element and the position before the first.
+		iterator last() { return _promoted ? iterator(_tree.rbegin().base()) : position(std::ptrdiff_t(_size) - 1); }
+		const_iterator last() const { return _promoted ? const_iterator(_tree.rbegin().base()) : position(std::ptrdiff_t(_size) - 1); }
+		iterator before_begin() { return _promoted ? iterator(_tree.rend().base()) : position(-1); }
+		const_iterator before_begin() const { return _promoted ? const_iterator(_tree.rend().base()) : position(-1); }
+
+		iterator find(const Key &k) {
+			if (_promoted)
+				return iterator(_tree.find(k));
+			return position(findIndex(k));
+		}
+
+		const_iterator find(const Key &k) const {
+			if (_promoted)
+				return const_iterator(_tree.find(k));
+			return position(findIndex(k));
+		}
+
+		iterator lower_bound(const Key &k) {
+			if (_promoted)
+				return iterator(_tree.lower_bound(k));
+			return position(lowerIndex(k));
+		}
+
+		const_iterator lower_bound(const Key &k) const {
+			if (_promoted)
+				return const_iterator(_tree.lower_bound(k));
+			return position(lowerIndex(k));
+		}
+
+		iterator upper_bound(const Key &k) {
+			if (_promoted)
+				return iterator(_tree.upper_bound(k));
+			return position(upperIndex(k));
+		}
+
+		const_iterator upper_bound(const Key &k) const {
+			if (_promoted)
+				return const_iterator(_tree.upper_bound(k));
+			return position(upperIndex(k));
+		}
+
+		ft::pair<iterator, bool> insert_unique(const Value &value) {
+			if (_promoted) {
+				ft::pair<typename Tree::iterator, bool> res = _tree.insert(value);
+				return ft::make_pair(iterator(res.first), res.second);
+			}
+			const Key &k = KeyOfValue()(value);
+			size_type i = lowerIndex(k);
+			if (i < _size && !_comp(k, key(i)))
+				return ft::make_pair(position(i), false);
+			if (_size == N) {
+				promote();
+				return insert_unique(value);
+			}
+			openGap(i, relocatable());
+			try {
+				::new (static_cast<void *>(slot(i))) Value(value);
+			} catch (...) {
+				++_size;
+				closeGap(i, relocatable());
+				--_size;
+				throw;
+			}
+			++_size;
+			return ft::make_pair(position(i), true);
+		}
+
+		void erase(const_iterator pos) {
+			if (_promoted) {
+				_tree.erase(mutableIt(pos.tree_iterator()));
+				return;
+			}
+			size_type i = pos.index();
+			slot(i)->~Value();
+			closeGap(i, relocatable());
+			--_size;
+		}
+
+		void erase(const_iterator first, const_iterator last) {
+			if (_promoted) {
+				_tree.erase(mutableIt(first.tree_iterator()), mutableIt(last.tree_iterator()));
+				return;
+			}
+			for (size_type count = last.index() - first.index(); count; --count)
+				erase(first);
+		}
+
+		size_type erase(const Key &k) {
+			if (_promoted)
+				return _tree.erase(k);
+			size_type i = findIndex(k);
+			if (i == _size)
+				return 0;
+			erase(position(i));
+			return 1;
+		}
+
+		void clear() {
+			destroyInline();
+			_tree.clear();
+			_promoted = false;
+		}
+
+		// The inline values are relocated between the two arrays, so unlike the
+		// tree part this is O(N), and for values that are not trivially relocatable
+		// a throwing copy leaves both containers valid but not fully swapped.
+		void swap(SmallTree &other) {
+			if (this != &other) {
+				swapInline(other, relocatable());
+				_tree.swap(other._tree);
+				std::swap(_comp, other._comp);
+				std::swap(_promoted, other._promoted);
+			}
+		}
+
+	private:
+		void swapInline(SmallTree &other, ft::integral_constant<bool, true>) {
+			char tmp[sizeof(_inline)];
+			std::memcpy(tmp, _inline, _size * sizeof(Value));
+			std::memcpy(_inline, other._inline, other._size * sizeof(Value));
+			std::memcpy(other._inline, tmp, _size * sizeof(Value));
+			std::swap(_size, other._size);
+		}
+
+		void swapInline(SmallTree &other, ft::integral_constant<bool, false>) {
+			SmallTree *from = this, *to = &other;
+			if (_size < other._size)
+				std::swap(from, to);
+			// Exchange the common prefix through a temporary, then move the rest over.
+			size_type common = to->_size;
+			for (size_type i = 0; i < common; ++i) {
+				Value tmp(*from->slot(i));
+				from->slot(i)->~Value();
+				try {
+					::new (static_cast<void *>(from->slot(i))) Value(*to->slot(i));
+				} catch (...) {
+					from->dropFrom(i + 1, from->_size);
+					from->_size = i;
+					throw;
+				}
+				to->slot(i)->~Value();
+				try {
+					::new (static_cast<void *>(to->slot(i))) Value(tmp);
+				} catch (...) {
+					to->dropFrom(i + 1, to->_size);
+					to->_size = i;
+					throw;
+				}
+			}
+			for (; to->_size < from->_size; ++to->_size)
+				::new (static_cast<void *>(to->slot(to->_size))) Value(*from->slot(to->_size));
+			from->dropFrom(common, from->_size);
+			from->_size = common;
+		}
+	};
+
+	// Map that keeps up to N entries inline (see SmallTree) before becoming an
+	// ft::Map. Same interface as Map plus promoted().
+	template < class Key, class T, std::size_t N = 8, class Compare = std::less<Key>,
+			   class A = std::allocator< std::pair<const Key, T> > >
+	class SmallMap {
+	public:
+		typedef Key																key_type;
+		typedef T																mapped_type;
+		typedef ft::pair<const Key, T>											value_type;
+		typedef std::size_t														size_type;
+		typedef std::ptrdiff_t													difference_type;
+		typedef Compare															key_compare;
+		typedef A																allocator_type;
+		typedef value_type&														reference;
+		typedef const value_type&												const_reference;
+		typedef ft::Map<Key, T, Compare, A>										map_type;
+		typedef ft::SmallTree<value_type, Key, ft::select_first<value_type>, Compare, map_type, N>	tree_type;
+		typedef typename tree_type::iterator									iterator;
+		typedef typename tree_type::const_iterator								const_iterator;
+		typedef ft::reverse_iterator<iterator>									reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>							const_reverse_iterator;
+		typedef typename map_type::value_compare								value_compare;
+
+	private:
+		tree_type	_tree;
+
+	public:
+		SmallMap() {}
+		explicit SmallMap(const Compare &comp, const A &alloc = A()) : _tree(comp, alloc) {}
+
+		template <class InputIt>
+		SmallMap(InputIt first, InputIt last, const Compare &comp = Compare(), const A &alloc = A())
+			: _tree(comp, alloc) { insert(first, last); }
+
+		SmallMap(const SmallMap &other) : _tree(other._tree) {}
+
+		SmallMap &operator=(const SmallMap &other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		~SmallMap() {}
+
+		allocator_type get_allocator() const { return _tree.get_allocator(); }
+
+		T &at(const Key &key) {
+			iterator it = _tree.find(key);
+			if (it == end())
+				throw std::out_of_range("key not found");
+			return it->second;
+		}
+
+		const T &at(const Key &key) const {
+			const_iterator it = _tree.find(key);
+			if (it == end())
+				throw std::out_of_range("key not found");
+			return it->second;
+		}
+
+		T &operator[](const Key &key) { return insert(ft::make_pair(key, T())).first->second; }
+
+		iterator begin() { return _tree.begin(); }
+		const_iterator begin() const { return _tree.begin(); }
+		iterator end() { return _tree.end(); }
+		const_iterator end() const { return _tree.end(); }
+		reverse_iterator rbegin() { return reverse_iterator(_tree.last()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(_tree.last()); }
+		reverse_iterator rend() { return reverse_iterator(_tree.before_begin()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(_tree.before_begin()); }
+
+		bool empty() const { return _tree.size() == 0; }
+		size_type size() const { return _tree.size(); }
+		size_type max_size() const { return _tree.max_size(); }
+		bool promoted() const { return _tree.promoted(); }
+		size_type memory_usage() const { return sizeof(*this) - sizeof(tree_type) + _tree.memory_usage(); }
+
+		void clear() { _tree.clear(); }
+
+		ft::pair<iterator, bool> insert(const value_type &value) { return _tree.insert_unique(value); }
+		iterator insert(iterator, const value_type &value) { return _tree.insert_unique(value).first; }
+
+		template <class InputIt>
+		void insert(InputIt first, InputIt last) {
+			for (; first != last; ++first)
+				_tree.insert_unique(value_type(first->first, first->second));
+		}
+
+		void erase(iterator pos) { _tree.erase(pos); }
+
+		void erase(iterator first, iterator last) { _tree.erase(first, last); }
+
+		size_type erase(const Key &key) { return _tree.erase(key); }
+
+		void swap(SmallMap &other) { _tree.swap(other._tree); }
+
+		size_type count(const Key &key) const { return _tree.find(key) != end(); }
+		iterator find(const Key &key) { return _tree.find(key); }
+		const_iterator find(const Key &key) const { return _tree.find(key); }
+		iterator lower_bound(const Key &key) { return _tree.lower_bound(key); }
+		const_iterator lower_bound(const Key &key) const { return _tree.lower_bound(key); }
+		iterator upper_bound(const Key &key) { return _tree.upper_bound(key); }
+		const_iterator upper_bound(const Key &key) const { return _tree.upper_bound(key); }
+		ft::pair<iterator, iterator> equal_range(const Key &key)
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+		ft::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+
+		key_compare key_comp() const { return _tree.key_comp(); }
+		value_compare value_comp() const { return map_type(_tree.key_comp()).value_comp(); }
+
+		friend bool operator==(const SmallMap &lhs, const SmallMap &rhs)
+			{ return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+		friend bool operator!=(const SmallMap &lhs, const SmallMap &rhs) { return !(lhs == rhs); }
+		friend bool operator<(const SmallMap &lhs, const SmallMap &rhs)
+			{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+		friend bool operator>(const SmallMap &lhs, const SmallMap &rhs) { return rhs < lhs; }
+		friend bool operator<=(const SmallMap &lhs, const SmallMap &rhs) { return !(rhs < lhs); }
+		friend bool operator>=(const SmallMap &lhs, const SmallMap &rhs) { return !(lhs < rhs); }
+	};
+
+	// Set counterpart of SmallMap over an ft::Set; elements are immutable, so both
+	// iterators are const.
+	template < class Key, std::size_t N = 8, class Compare = std::less<Key>, class A = std::allocator<Key> >
+	class SmallSet {
+	public:
+		typedef Key															key_type;
+		typedef Key															value_type;
+		typedef std::size_t													size_type;
+		typedef std::ptrdiff_t												difference_type;
+		typedef Compare														key_compare;
+		typedef Compare														value_compare;
+		typedef A															allocator_type;
+		typedef value_type&													reference;
+		typedef const value_type&											const_reference;
+		typedef ft::Set<Key, Compare, A>									set_type;
+		typedef ft::SmallTree<Key, Key, ft::identity<Key>, Compare, set_type, N>	tree_type;
+		typedef typename tree_type::const_iterator							iterator;
+		typedef iterator													const_iterator;
+		typedef ft::reverse_iterator<iterator>								reverse_iterator;
+		typedef reverse_iterator											const_reverse_iterator;
+
+	private:
+		tree_type	_tree;
+
+	public:
+		SmallSet() {}
+		explicit SmallSet(const Compare &comp, const A &alloc = A()) : _tree(comp, alloc) {}
+
+		template <class InputIt>
+		SmallSet(InputIt first, InputIt last, const Compare &comp = Compare(), const A &alloc = A())
+			: _tree(comp, alloc) { insert(first, last); }
+
+		SmallSet(const SmallSet &other) : _tree(other._tree) {}
+
+		SmallSet &operator=(const SmallSet &other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		~SmallSet() {}
+
+		allocator_type get_allocator() const { return _tree.get_allocator(); }
+
+		iterator begin() const { return _tree.begin(); }
+		iterator end() const { return _tree.end(); }
+		reverse_iterator rbegin() const { return reverse_iterator(_tree.last()); }
+		reverse_iterator rend() const { return reverse_iterator(_tree.before_begin()); }
+
+		bool empty() const { return _tree.size() == 0; }
+		size_type size() const { return _tree.size(); }
+		size_type max_size() const { return _tree.max_size(); }
+		bool promoted() const { return _tree.promoted(); }
+		size_type memory_usage() const { return sizeof(*this) - sizeof(tree_type) + _tree.memory_usage(); }
+
+		void clear() { _tree.clear(); }
+
+		ft::pair<iterator, bool> insert(const value_type &value) {
+			ft::pair<typename tree_type::iterator, bool> res = _tree.insert_unique(value);
+			return ft::make_pair(iterator(res.first), res.second);
+		}
+
+		iterator insert(iterator, const value_type &value) { return _tree.insert_unique(value).first; }
+
+		template <class InputIt>
+		void insert(InputIt first, InputIt last) {
+			for (; first != last; ++first)
+				_tree.insert_unique(*first);
+		}
+
+		void erase(iterator pos) { _tree.erase(pos); }
+
+		void erase(iterator first, iterator last) { _tree.erase(first, last); }
+
+		size_type erase(const Key &key) { return _tree.erase(key); }
+
+		void swap(SmallSet &other) { _tree.swap(other._tree); }
+
+		size_type count(const Key &key) const { return _tree.find(key) != end(); }
+		iterator find(const Key &key) const { return _tree.find(key); }
+		iterator lower_bound(const Key &key) const { return _tree.lower_bound(key); }
+		iterator upper_bound(const Key &key) const { return _tree.upper_bound(key); }
+		ft::pair<iterator, iterator> equal_range(const Key &key) const
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+
+		key_compare key_comp() const { return _tree.key_comp(); }
+		value_compare value_comp() const { return _tree.key_comp(); }
+
+		friend bool operator==(const SmallSet &lhs, const SmallSet &rhs)
+			{ return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+		friend bool operator!=(const SmallSet &lhs, const SmallSet &rhs) { return !(lhs == rhs); }
+		friend bool operator<(const SmallSet &lhs, const SmallSet &rhs)
+			{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+		friend bool operator>(const SmallSet &lhs, const SmallSet &rhs) { return rhs < lhs; }
+		friend bool operator<=(const SmallSet &lhs, const SmallSet &rhs) { return !(rhs < lhs); }
+		friend bool operator>=(const SmallSet &lhs, const SmallSet &rhs) { return !(lhs < rhs); }
+	};
+}
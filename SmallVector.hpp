@@ -0,0 +1,287 @@
+#pragma once
+
+#include "Iterator.hpp"
+
+namespace ft {
+	template < class T, std::size_t N, class A = std::allocator<T> >
+class SmallVector {
+public:
+	typedef T										value_type;
+	typedef A										allocator_type;
+	typedef std::size_t								size_type;
+	typedef std::ptrdiff_t							difference_type;
+	typedef value_type&								reference;
+	typedef const value_type&						const_reference;
+	typedef T*										pointer;
+	typedef const T*								const_pointer;
+	typedef ft::iterator<T*>						iterator;
+	typedef ft::iterator<const T*>					const_iterator;
+	typedef ft::reverse_iterator<iterator>			reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+private:
+	pointer			buffer;
+	size_type		_capacity;
+	size_type		_size;
+	allocator_type	allocator;
+	char			_inline[N * sizeof(T)] __attribute__((aligned(__alignof__(T))));
+
+	pointer inline_buffer() { return reinterpret_cast<pointer>(_inline); }
+	bool is_inline() const { return buffer == reinterpret_cast<const_pointer>(_inline); }
+
+public:
+	explicit SmallVector(const A& alloc = A()) : buffer(inline_buffer()), _capacity(N), _size(0), allocator(alloc) {}
+
+	SmallVector(size_type count, const_reference value = value_type(), const A& alloc = A())
+		: buffer(inline_buffer()), _capacity(N), _size(0), allocator(alloc) {
+		assign(count, value);
+	};
+
+	template <class InputIterator>
+	SmallVector(InputIterator first, InputIterator last, const A& alloc = A(),
+		   typename ft::enable_if<!ft::is_integral<InputIterator>::value, void>::type* = 0)
+		: buffer(inline_buffer()), _capacity(N), _size(0), allocator(alloc) {
+		assign(first, last);
+	};
+
+	SmallVector(const SmallVector& other)
+		: buffer(inline_buffer()), _capacity(N), _size(0), allocator(other.get_allocator()) {
+		assign(other.begin(), other.end());
+	};
+
+	~SmallVector() {
+		this->clear();
+		if (!is_inline())
+			allocator.deallocate(buffer, _capacity);
+	};
+
+	SmallVector& operator=(const SmallVector& other) {
+		if (this == &other)
+			return *this;
+		assign(other.begin(), other.end());
+		return *this;
+	};
+
+	void assign(size_type count, const_reference value) {
+		this->clear();
+		this->reserve(count);
+		for (; _size < count; ++_size)
+			allocator.construct(buffer + _size, value);
+	};
+
+	template <class InputIterator>
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value, void>::type
+	assign(InputIterator first, InputIterator last) {
+		this->clear();
+		for (; first != last; ++first)
+			this->push_back(*first);
+	};
+
+	allocator_type get_allocator() const { return this->allocator; };
+
+	reference at( size_type pos ) {
+		if (pos >= _size)
+			throw std::out_of_range("SmallVector");
+		return buffer[pos];
+	};
+
+	const_reference at( size_type pos ) const {
+		if (pos >= _size)
+			throw std::out_of_range("SmallVector");
+		return buffer[pos];
+	};
+
+	reference operator[]( size_type pos ) { return buffer[pos]; };
+	const_reference operator[]( size_type pos ) const { return buffer[pos]; };
+	reference front() { return *buffer; };
+	const_reference front() const { return *buffer; };
+	reference back() { return buffer[_size - 1]; };
+	const_reference back() const { return buffer[_size - 1]; };
+	pointer data() { return buffer; };
+	const_pointer data() const { return buffer; };
+	iterator begin() { return iterator(buffer); };
+	const_iterator begin() const { return const_iterator(buffer); };
+	iterator end() { return iterator(buffer + _size); };
+	const_iterator end() const { return const_iterator(buffer + _size); };
+	reverse_iterator rbegin() { return reverse_iterator(iterator(buffer + _size - 1)); };
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(const_iterator(buffer + _size - 1)); };
+	reverse_iterator rend() { return reverse_iterator(iterator(buffer - 1)); };
+	const_reverse_iterator rend() const { return const_reverse_iterator(const_iterator(buffer - 1)); };
+	bool empty() const { return _size == 0; };
+	size_type size() const { return _size; };
+	size_type capacity() const { return _capacity; };
+	size_type max_size() const { return (std::min((size_type) std::numeric_limits<difference_type>::max(),
+														std::numeric_limits<size_type>::max() / sizeof(value_type))); };
+	// The inline buffer is part of sizeof(*this); a spilled buffer is counted in full.
+	size_type memory_usage() const { return sizeof(*this) + (is_inline() ? 0 : _capacity * sizeof(value_type)); };
+
+	void reserve(size_type size)
+	{
+		if (size <= _capacity)
+			return;
+		pointer tmp = allocator.allocate(size);
+		size_type i = 0;
+		try {
+			for (; i < _size; ++i)
+				allocator.construct(tmp + i, buffer[i]);
+		} catch (...) {
+			while (i)
+				allocator.destroy(tmp + --i);
+			allocator.deallocate(tmp, size);
+			throw;
+		}
+		for (i = 0; i < _size; ++i)
+			allocator.destroy(buffer + i);
+		if (!is_inline())
+			allocator.deallocate(buffer, _capacity);
+		buffer = tmp;
+		_capacity = size;
+	};
+
+	void clear()
+	{
+		for (size_type i = 0; i < _size; i++)
+			allocator.destroy(buffer + i);
+		_size = 0;
+	};
+
+	void insert( iterator pos, size_type count, const T& value )
+	{
+		size_type index = pos - begin();
+		if (!count)
+			return;
+		value_type copy(value);
+		if (_size + count > _capacity)
+			reserve(std::max(_size + count, _capacity * 2));
+		// [high, end) and [_size, low) are the slots built past _size so far; if a
+		// copy throws they are destroyed and _size is left as it was.
+		size_type end = _size + count;
+		size_type high = end;
+		size_type low = _size;
+		try {
+			for (size_type i = _size; i-- > index;) {
+				if (i + count >= _size) {
+					allocator.construct(buffer + i + count, buffer[i]);
+					high = i + count;
+				} else
+					buffer[i + count] = buffer[i];
+			}
+			for (size_type i = index; i < index + count; ++i) {
+				if (i < _size)
+					buffer[i] = copy;
+				else {
+					allocator.construct(buffer + i, copy);
+					low = i + 1;
+				}
+			}
+		} catch (...) {
+			while (high != end)
+				allocator.destroy(buffer + high++);
+			while (low != _size)
+				allocator.destroy(buffer + --low);
+			throw;
+		}
+		_size += count;
+	};
+
+	iterator insert(iterator pos, const_reference value)
+	{
+		size_type index = pos - begin();
+		this->insert(pos, 1, value);
+		return (iterator(buffer + index));
+	};
+
+	template <class InputIt>
+	typename ft::enable_if<!ft::is_integral<InputIt>::value, void>::type
+	insert( iterator pos, InputIt first, InputIt last)
+	{
+		size_type index = pos - begin();
+		size_type old_size = _size;
+		try {
+			for (; first != last; ++first)
+				push_back(*first);
+		} catch (...) {
+			while (_size != old_size)
+				pop_back();
+			throw;
+		}
+		std::rotate(buffer + index, buffer + old_size, buffer + _size);
+	};
+
+	iterator erase( iterator pos )
+	{
+		return erase(pos, pos + 1);
+	}
+
+	iterator erase( iterator first, iterator last )
+	{
+		size_type start = first - begin();
+		size_type offset = last - first;
+
+		for (size_type i = start; i + offset < _size; ++i)
+			buffer[i] = buffer[i + offset];
+		for (size_type i = _size - offset; i < _size; ++i)
+			allocator.destroy(buffer + i);
+		_size -= offset;
+		return iterator(buffer + start);
+	}
+
+	void push_back( const_reference value )
+	{
+		if (_size == _capacity) {
+			value_type copy(value);
+			this->reserve(_capacity ? _capacity * 2 : 1);
+			allocator.construct(buffer + _size, copy);
+		} else
+			allocator.construct(buffer + _size, value);
+		++_size;
+	};
+
+	void pop_back() {
+		allocator.destroy(buffer + --_size);
+	}
+
+	void resize( size_type count, T value = T() )
+	{
+		if (count < _size)
+		{
+			while (_size != count)
+				pop_back();
+		} else
+		{
+			reserve(count);
+			for (; _size < count; ++_size)
+				allocator.construct(buffer + _size, value);
+		}
+	}
+
+	void swap( SmallVector& other )
+	{
+		if (!is_inline() && !other.is_inline()) {
+			std::swap(_size, other._size);
+			std::swap(_capacity, other._capacity);
+			std::swap(buffer, other.buffer);
+			std::swap(allocator, other.allocator);
+			return;
+		}
+		SmallVector tmp(*this);
+		*this = other;
+		other = tmp;
+	}
+
+	friend bool operator== (const SmallVector &lhs, const SmallVector &rhs)
+	{
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	};
+
+	friend bool operator!= (const SmallVector &lhs, const SmallVector &rhs) { return !(lhs == rhs); };
+
+	friend bool operator< (const SmallVector &lhs, const SmallVector &rhs)
+	{
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	};
+
+	friend bool operator> (const SmallVector &lhs, const SmallVector &rhs) { return rhs < lhs; };
+	friend bool operator<= (const SmallVector &lhs, const SmallVector &rhs) { return !(rhs < lhs); };
+	friend bool operator>= (const SmallVector &lhs, const SmallVector &rhs) { return !(lhs < rhs); };
+};
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Map.hpp"
+#include "Set.hpp"
+
+namespace ft {
+	enum snapshot_kind {
+		SNAPSHOT_VECTOR = 1,
+		SNAPSHOT_SET = 2,
+		SNAPSHOT_MAP = 3
+	};
+
+	// On-disk layout: one 64-byte header followed by `count` packed records in
+	// container order. Records are raw native-endian bytes of trivially copyable types.
+	struct snapshot_header {
+		char		magic[8];
+		uint32_t	version;
+		uint32_t	byte_order;
+		uint32_t	kind;
+		uint32_t	key_size;
+		uint32_t	value_size;
+		uint32_t	record_size;
+		uint64_t	count;
+		char		reserved[24];
+	};
+
+	static const char		snapshot_magic[8] = { 'F', 'T', 'S', 'N', 'A', 'P', 0, 0 };
+	static const uint32_t	snapshot_version = 1;
+	static const uint32_t	snapshot_byte_order = 0x01020304;
+
+	template <class Key, class T>
+	struct snapshot_record {
+		Key	first;
+		T	second;
+	};
+
+	class snapshot_writer {
+		FILE	*_file;
+
+		snapshot_writer(const snapshot_writer &);
+		snapshot_writer &operator=(const snapshot_writer &);
+	public:
+		snapshot_writer(const char *path, uint32_t kind, uint32_t key_size,
+						uint32_t value_size, uint32_t record_size, uint64_t count)
+			: _file(std::fopen(path, "wb")) {
+			if (!_file)
+				throw std::runtime_error("snapshot: cannot open file for writing");
+			snapshot_header header;
+			std::memset(&header, 0, sizeof(header));
+			std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+			header.version = snapshot_version;
+			header.byte_order = snapshot_byte_order;
+			header.kind = kind;
+			header.key_size = key_size;
+			header.value_size = value_size;
+			header.record_size = record_size;
+			header.count = count;
+			write(&header, sizeof(header));
+		}
+
+		~snapshot_writer() {
+			if (_file)
+				std::fclose(_file);
+		}
+
+		void write(const void *data, size_t bytes) {
+			if (bytes && std::fwrite(data, 1, bytes, _file) != bytes)
+				throw std::runtime_error("snapshot: write failed");
+		}
+
+		void close() {
+			FILE *file = _file;
+			_file = 0;
+			if (std::fclose(file) != 0)
+				throw std::runtime_error("snapshot: write failed");
+		}
+	};
+
+	class snapshot_mapping {
+		void	*_base;
+		size_t	_length;
+
+		snapshot_mapping(const snapshot_mapping &);
+		snapshot_mapping &operator=(const snapshot_mapping &);
+	public:
+		snapshot_mapping(const char *path, uint32_t kind, uint32_t key_size,
+						 uint32_t value_size, uint32_t record_size)
+			: _base(MAP_FAILED), _length(0) {
+			int fd = ::open(path, O_RDONLY);
+			if (fd < 0)
+				throw std::runtime_error("snapshot: cannot open file for reading");
+			struct stat st;
+			if (::fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(snapshot_header)) {
+				::close(fd);
+				throw std::runtime_error("snapshot: truncated file");
+			}
+			_length = st.st_size;
+			_base = ::mmap(0, _length, PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd);
+			if (_base == MAP_FAILED)
+				throw std::runtime_error("snapshot: mmap failed");
+			const snapshot_header &h = header();
+			if (std::memcmp(h.magic, snapshot_magic, sizeof(h.magic)) != 0
+				|| h.version != snapshot_version || h.byte_order != snapshot_byte_order) {
+				::munmap(_base, _length);
+				throw std::runtime_error("snapshot: unsupported format");
+			}
+			if (h.kind != kind || h.key_size != key_size || h.value_size != value_size
+				|| h.record_size != record_size
+				|| h.count != (_length - sizeof(snapshot_header)) / record_size
+				|| (_length - sizeof(snapshot_header)) % record_size != 0) {
+				::munmap(_base, _length);
+				throw std::runtime_error("snapshot: layout mismatch");
+			}
+		}
+
+		~snapshot_mapping() {
+			if (_base != MAP_FAILED)
+				::munmap(_base, _length);
+		}
+
+		const snapshot_header &header() const
+			{ return *static_cast<const snapshot_header *>(_base); }
+		const void *records() const
+			{ return static_cast<const char *>(_base) + sizeof(snapshot_header); }
+		size_t count() const
+			{ return header().count; }
+	};
+
+	template <class T>
+	class MappedVector {
+		snapshot_mapping	_mapping;
+	public:
+		typedef T				value_type;
+		typedef std::size_t		size_type;
+		typedef const T&		const_reference;
+		typedef const T*		const_pointer;
+		typedef const T*		const_iterator;
+
+		explicit MappedVector(const char *path)
+			: _mapping(path, SNAPSHOT_VECTOR, 0, sizeof(T), sizeof(T)) {}
+
+		const_pointer data() const { return static_cast<const T *>(_mapping.records()); }
+		const_iterator begin() const { return data(); }
+		const_iterator end() const { return data() + size(); }
+		size_type size() const { return _mapping.count(); }
+		bool empty() const { return size() == 0; }
+		const_reference operator[](size_type pos) const { return data()[pos]; }
+		const_reference at(size_type pos) const {
+			if (pos >= size())
+				throw std::out_of_range("MappedVector");
+			return data()[pos];
+		}
+	};
+
+	template <class Key, class Compare = std::less<Key> >
+	class MappedSet {
+		snapshot_mapping	_mapping;
+		Compare				_comp;
+	public:
+		typedef Key				key_type;
+		typedef Key				value_type;
+		typedef std::size_t		size_type;
+		typedef const Key*		const_iterator;
+
+		explicit MappedSet(const char *path, const Compare &comp = Compare())
+			: _mapping(path, SNAPSHOT_SET, sizeof(Key), 0, sizeof(Key)), _comp(comp) {}
+
+		const_iterator begin() const { return static_cast<const Key *>(_mapping.records()); }
+		const_iterator end() const { return begin() + size(); }
+		size_type size() const { return _mapping.count(); }
+		bool empty() const { return size() == 0; }
+
+		const_iterator lower_bound(const Key &key) const
+			{ return std::lower_bound(begin(), end(), key, _comp); }
+		const_iterator upper_bound(const Key &key) const
+			{ return std::upper_bound(begin(), end(), key, _comp); }
+		const_iterator find(const Key &key) const {
+			const_iterator it = lower_bound(key);
+			return (it != end() && !_comp(key, *it)) ? it : end();
+		}
+		size_type count(const Key &key) const
+			{ return find(key) != end(); }
+	};
+
+	template <class Key, class T, class Compare = std::less<Key> >
+	class MappedMap {
+		typedef snapshot_record<Key, T>	record_type;
+
+		struct record_compare {
+			Compare comp;
+			record_compare(const Compare &c) : comp(c) {}
+			bool operator()(const record_type &r, const Key &key) const { return comp(r.first, key); }
+			bool operator()(const Key &key, const record_type &r) const { return comp(key, r.first); }
+		};
+
+		snapshot_mapping	_mapping;
+		record_compare		_comp;
+	public:
+		typedef Key					key_type;
+		typedef T					mapped_type;
+		typedef record_type			value_type;
+		typedef std::size_t			size_type;
+		typedef const record_type*	const_iterator;
+
+		explicit MappedMap(const char *path, const Compare &comp = Compare())
+			: _mapping(path, SNAPSHOT_MAP, sizeof(Key), sizeof(T), sizeof(record_type)), _comp(comp) {}
+
+		const_iterator begin() const { return static_cast<const record_type *>(_mapping.records()); }
+		const_iterator end() const { return begin() + size(); }
+		size_type size() const { return _mapping.count(); }
+		bool empty() const { return size() == 0; }
+
+		const_iterator lower_bound(const Key &key) const
+			{ return std::lower_bound(begin(), end(), key, _comp); }
+		const_iterator upper_bound(const Key &key) const
+			{ return std::upper_bound(begin(), end(), key, _comp); }
+		const_iterator find(const Key &key) const {
+			const_iterator it = lower_bound(key);
+			return (it != end() && !_comp(key, *it)) ? it : end();
+		}
+		size_type count(const Key &key) const
+			{ return find(key) != end(); }
+		const T &at(const Key &key) const {
+			const_iterator it = find(key);
+			if (it == end())
+				throw std::out_of_range("key not found");
+			return it->second;
+		}
+	};
+
+	template <class T, class A>
+	typename ft::enable_if<ft::is_trivially_copyable<T>::value, void>::type
+	write_snapshot(const char *path, const ft::Vector<T, A> &v) {
+		snapshot_writer out(path, SNAPSHOT_VECTOR, 0, sizeof(T), sizeof(T), v.size());
+		out.write(v.data(), v.size() * sizeof(T));
+		out.close();
+	}
+
+	template <class Key, class Compare, class A>
+	typename ft::enable_if<ft::is_trivially_copyable<Key>::value, void>::type
+	write_snapshot(const char *path, const ft::Set<Key, Compare, A> &s) {
+		snapshot_writer out(path, SNAPSHOT_SET, sizeof(Key), 0, sizeof(Key), s.size());
+		Key chunk[1024 / sizeof(Key) + 1];
+		size_t n = 0;
+		for (typename ft::Set<Key, Compare, A>::const_iterator it = s.begin(); it != s.end(); ++it) {
+			std::memcpy(chunk + n, &*it, sizeof(Key));
+			if (++n == sizeof(chunk) / sizeof(Key)) {
+				out.write(chunk, sizeof(chunk));
+				n = 0;
+			}
+		}
+		out.write(chunk, n * sizeof(Key));
+		out.close();
+	}
+
+	template <class Key, class T, class Compare, class A>
+	typename ft::enable_if<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<T>::value, void>::type
+	write_snapshot(const char *path, const ft::Map<Key, T, Compare, A> &m) {
+		typedef snapshot_record<Key, T> record_type;
+		snapshot_writer out(path, SNAPSHOT_MAP, sizeof(Key), sizeof(T), sizeof(record_type), m.size());
+		record_type chunk[1024 / sizeof(record_type) + 1];
+		size_t n = 0;
+		std::memset(chunk, 0, sizeof(chunk));
+		for (typename ft::Map<Key, T, Compare, A>::const_iterator it = m.begin(); it != m.end(); ++it) {
+			std::memcpy(&chunk[n].first, &it->first, sizeof(Key));
+			std::memcpy(&chunk[n].second, &it->second, sizeof(T));
+			if (++n == sizeof(chunk) / sizeof(record_type)) {
+				out.write(chunk, sizeof(chunk));
+				n = 0;
+			}
+		}
+		out.write(chunk, n * sizeof(record_type));
+		out.close();
+	}
+
+	template <class T, class A>
+	typename ft::enable_if<ft::is_trivially_copyable<T>::value, void>::type
+	read_snapshot(const char *path, ft::Vector<T, A> &v) {
+		MappedVector<T> snapshot(path);
+		v.assign(snapshot.begin(), snapshot.end());
+	}
+
+	template <class Key, class Compare, class A>
+	typename ft::enable_if<ft::is_trivially_copyable<Key>::value, void>::type
+	read_snapshot(const char *path, ft::Set<Key, Compare, A> &s) {
+		MappedSet<Key, Compare> snapshot(path, s.key_comp());
+		s.assign_sorted(snapshot.begin(), snapshot.end());
+	}
+
+	template <class Key, class T, class Compare, class A>
+	typename ft::enable_if<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<T>::value, void>::type
+	read_snapshot(const char *path, ft::Map<Key, T, Compare, A> &m) {
+		MappedMap<Key, T, Compare> snapshot(path, m.key_comp());
+		m.assign_sorted(snapshot.begin(), snapshot.end());
+	}
+}
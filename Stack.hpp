@@ -13,7 +13,13 @@ namespace ft {
 		typedef typename Container::reference		reference;
 		typedef typename Container::const_reference	const_reference;
 
+#if __cplusplus >= 201103L
+		Stack() : _container() {};
+		explicit Stack(const Container &cont) : _container(cont) {};
+		explicit Stack(Container &&cont) : _container(std::move(cont)) {};
+#else
 		explicit Stack(const Container &cont = Container()) { _container = cont; };
+#endif
 		Stack(const Stack &other) { _container = other._container; };
 		~Stack() {};
 		Stack& operator=(const Stack &other) 
@@ -27,7 +33,13 @@ namespace ft {
 		const_reference top() const { return _container.back(); };
 		bool empty() const { return _container.empty(); };
 		size_type size() const { return _container.size(); };
+		size_type memory_usage() const { return sizeof(*this) - sizeof(Container) + _container.memory_usage(); };
 		void push(const value_type &value) { _container.push_back(value); };
+#if __cplusplus >= 201103L
+		void push(value_type &&value) { _container.push_back(std::move(value)); };
+		template <class... Args>
+		void emplace(Args&&... args) { _container.emplace_back(std::forward<Args>(args)...); };
+#endif
 		void pop() { _container.pop_back(); };
 		friend bool operator==(const Stack &lhs, const Stack &rhs) { return lhs._container == rhs._container; };
 		friend bool operator!=(const Stack &lhs, const Stack &rhs) { return lhs._container != rhs._container; };
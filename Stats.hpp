@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+
+#ifdef FT_STATS
+# define FT_STAT(expr) (expr)
+#else
+# define FT_STAT(expr) ((void)0)
+#endif
+
+namespace ft {
+	struct tree_stats {
+		size_t lookups;
+		size_t comparisons;
+		size_t rotate_left;
+		size_t rotate_right;
+		size_t insert_fixup_iterations;
+		size_t delete_fixup_iterations;
+		size_t begin_walks;
+		size_t last_walks;
+		size_t allocations;
+		size_t allocated_bytes;
+		size_t height;
+
+		tree_stats()
+			: lookups(0), comparisons(0), rotate_left(0), rotate_right(0),
+			  insert_fixup_iterations(0), delete_fixup_iterations(0),
+			  begin_walks(0), last_walks(0), allocations(0), allocated_bytes(0), height(0) {}
+
+		void allocated(size_t bytes) {
+			++allocations;
+			allocated_bytes += bytes;
+		}
+	};
+
+	struct vector_stats {
+		size_t allocations;
+		size_t allocated_bytes;
+		size_t reallocations;
+		size_t copied_bytes;
+
+		vector_stats()
+			: allocations(0), allocated_bytes(0), reallocations(0), copied_bytes(0) {}
+
+		void allocated(size_t bytes) {
+			++allocations;
+			allocated_bytes += bytes;
+		}
+	};
+
+	// Filled in by ft::tracking_allocator; counts every allocator call regardless of FT_STATS.
+	struct allocation_stats {
+		size_t live_bytes;
+		size_t peak_bytes;
+		size_t allocations;
+		size_t deallocations;
+
+		allocation_stats()
+			: live_bytes(0), peak_bytes(0), allocations(0), deallocations(0) {}
+
+		void allocated(size_t bytes) {
+			++allocations;
+			live_bytes += bytes;
+			if (live_bytes > peak_bytes)
+				peak_bytes = live_bytes;
+		}
+
+		void deallocated(size_t bytes) {
+			++deallocations;
+			live_bytes -= bytes;
+		}
+	};
+}
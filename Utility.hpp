@@ -1,6 +1,22 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#if __cplusplus >= 201103L
+# include <type_traits>
+# include <utility>
+# define FT_MOVE(x) std::move(x)
+# define FT_MOVE_IF_NOEXCEPT(x) std::move_if_noexcept(x)
+#else
+# define FT_MOVE(x) (x)
+# define FT_MOVE_IF_NOEXCEPT(x) (x)
+#endif
 
 namespace ft {
 	template <class T, class A>
@@ -34,6 +50,27 @@ namespace ft {
 	template<bool B, class T = void> struct enable_if {};
 	template<class T> struct enable_if<true, T> { typedef T type; };
 
+	template <class T, class U> struct is_same : public integral_constant<bool, false> {};
+	template <class T> struct is_same<T, T> : public integral_constant<bool, true> {};
+
+	template <class T> struct is_trivially_copyable : public integral_constant<bool, __is_trivially_copyable(T)> {};
+	// Types whose objects may be moved with memmove and not destroyed at the source.
+	// Specialize to opt in types that own resources but hold no self-pointers.
+	template <class T> struct is_trivially_relocatable : public is_trivially_copyable<T> {};
+
+	// Allocators whose copies may allocate and free concurrently from several
+	// threads. Map and Set only hand their nodes to another thread for these.
+	template <class A> struct is_thread_safe_allocator : public integral_constant<bool, false> {};
+	template <class T> struct is_thread_safe_allocator<std::allocator<T> > : public integral_constant<bool, true> {};
+
+	// How node-based containers get storage for one tree node or the value it
+	// holds. Allocators that keep single objects apart from buffers specialize it.
+	template <class A>
+	struct node_storage_traits {
+		static typename A::pointer allocate(A &a) { return a.allocate(1); }
+		static void deallocate(A &a, typename A::pointer p) { a.deallocate(p, 1); }
+	};
+
 template< class InputIt1, class InputIt2 >
 	bool equal( InputIt1 first1, InputIt1 last1, InputIt2 first2 )
 	{
@@ -70,22 +107,33 @@ template< class InputIt1, class InputIt2, class BinaryPredicate >
 		T2 second;
 		pair() : first(), second() {}
 		pair(T1 const& t1, T2 const& t2) : first(t1), second(t2) {}
+		// Copy construction and assignment stay implicit, so a pair of trivially
+		// copyable types is trivially copyable too and takes Vector's memcpy paths.
 
 		template <class U1, class U2>
 		pair(const pair<U1, U2>& p) : first(p.first), second(p.second) {}
 
-		pair& operator=(pair const& p) {
-			first = p.first;
-			second = p.second;
-			return *this;
-		}
-
 		void swap(pair& p) {
 			std::swap(first,  p.first);
 			std::swap(second, p.second);
 		}
 	};
 
+	template <class T1, class T2>
+	struct is_trivially_relocatable<pair<T1, T2> >
+		: public integral_constant<bool, is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
+	// Key extractors for containers that store whole values but order them by key.
+	template <class Pair>
+	struct select_first {
+		const typename Pair::first_type &operator()(const Pair &p) const { return p.first; }
+	};
+
+	template <class T>
+	struct identity {
+		const T &operator()(const T &x) const { return x; }
+	};
+
 	template <class T1, class T2>
 	inline bool operator==(const pair<T1, T2>& x, const pair<T1, T2>& y) {
 		return x.first == y.first && x.second == y.second;
@@ -1,8 +1,22 @@
 #pragma once
 
+#include <cstring>
 #include "Iterator.hpp"
+#include "Simd.hpp"
+#include "Stats.hpp"
 
 namespace ft {
+	template <class A>
+	struct default_storage_traits {
+		static bool reallocate(A&, typename A::pointer&, std::size_t, std::size_t)
+			{ return false; }
+		static typename A::pointer restore(A&, std::size_t& size, std::size_t& capacity)
+			{ size = capacity = 0; return 0; }
+	};
+
+	template <class A>
+	struct storage_traits : public default_storage_traits<A> {};
+
 	template < class T, class A = std::allocator<T> >
 class Vector {
 public:
@@ -19,22 +33,24 @@ public:
 	typedef ft::reverse_iterator<iterator>			reverse_iterator;
 	typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
 private:
+	typedef ft::integral_constant<bool, ft::is_trivially_relocatable<T>::value>	relocatable;
+
 	pointer			buffer;
 	size_type		_capacity;
 	size_type		_size;
 	allocator_type	allocator;
+#ifdef FT_STATS
+	ft::vector_stats _stats;
+#endif
 public:
 
-	explicit Vector(const A& alloc = A()) : buffer(0), _capacity(0), _size(0), allocator(alloc) {}
+	explicit Vector(const A& alloc = A()) : buffer(0), _capacity(0), _size(0), allocator(alloc) {
+		buffer = ft::storage_traits<A>::restore(allocator, _size, _capacity);
+	}
 
-	Vector(size_type count, const_reference value = value_type(), const A& alloc = A()) {
-		if (count < 0)
-			throw std::out_of_range("Vector");
-		allocator = alloc;
-		_capacity = _size = count;
-		buffer = allocator.allocate(_capacity);
-		for (size_t i = 0; i < count; ++i)
-			buffer[i] = value;
+	Vector(size_type count, const_reference value = value_type(), const A& alloc = A())
+		: buffer(0), _capacity(0), _size(0), allocator(alloc) {
+		this->assign(count, value);
 	};
 
 	template <class InputIterator>
@@ -44,12 +60,35 @@ public:
 		this->assign(first, last);
 	};
 
-	Vector(const Vector& other) : buffer(0), _capacity(other._capacity), _size(other._size), allocator(other.get_allocator()) {
+	Vector(const Vector& other) : buffer(0), _capacity(other._capacity), _size(0), allocator(other.get_allocator()) {
 		buffer = allocator.allocate(other._capacity);
-		for (size_t i = 0; i < _size; i++)
-			buffer[i] = other.buffer[i];
+		FT_STAT(_stats.allocated(_capacity * sizeof(value_type)));
+		try {
+			copy_construct(buffer, other.buffer, other._size);
+		} catch (...) {
+			allocator.deallocate(buffer, _capacity);
+			throw;
+		}
+		_size = other._size;
 	};
 
+#if __cplusplus >= 201103L
+	Vector(Vector&& other) noexcept
+		: buffer(other.buffer), _capacity(other._capacity), _size(other._size), allocator(std::move(other.allocator)) {
+		other.buffer = 0;
+		other._capacity = 0;
+		other._size = 0;
+	};
+
+	Vector& operator=(Vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+		Vector tmp(std::move(other));
+		this->swap(tmp);
+		return *this;
+	};
+#endif
+
 	~Vector() {
 		this->clear();
 		allocator.deallocate(buffer, _capacity);
@@ -59,36 +98,25 @@ public:
 		if (this == &other)
 			return *this;
 		this->clear();
-		allocator.deallocate(buffer, _capacity);
-		_capacity = other._capacity;
+		this->reserve(other._size);
+		copy_construct(buffer, other.buffer, other._size);
 		_size = other._size;
-		buffer = allocator.allocate(_capacity);
-		for (size_t i = 0; i < _size; ++i) {
-			buffer[i] = other.buffer[i];
-		}
 		return *this;
 	};
 
 	void assign(size_type count, const_reference value ) {
-		if (count < 0)
-			throw std::out_of_range("Vector");
+		value_type copy(value);
 		this->clear();
 		this->reserve(count);
-		for (size_t i = 0; i < count; ++i, _size++)
-			buffer[i] = value;
+		fill_construct(buffer, count, copy);
+		_size = count;
 	};
 
 
 	template <class InputIterator>
 	typename ft::enable_if<!ft::is_integral<InputIterator>::value, void>::type
 	assign(InputIterator first, InputIterator last) {
-		int range_size = last - first;
-		if (range_size < 0) throw std::length_error("Vector");
-		this->clear();
-		this->reserve(range_size);
-		for (; first != last; ++first) {
-			this->push_back(*first);
-		}
+		assign_range(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
 	};
 
 	allocator_type get_allocator() const { return this->allocator; };
@@ -126,14 +154,33 @@ public:
 	size_type capacity() const { return _capacity; };
 	size_type max_size() const { return (std::min((size_type) std::numeric_limits<difference_type>::max(),
 														std::numeric_limits<size_type>::max() / sizeof(value_type))); };
+	// Bytes held by the vector itself plus its whole buffer, spare capacity included.
+	// Memory owned by the elements (e.g. string contents) is not counted.
+	size_type memory_usage() const { return sizeof(*this) + _capacity * sizeof(value_type); };
+#ifdef FT_STATS
+	ft::vector_stats stats() const { return _stats; };
+#endif
 
 
 	void reserve(size_type size)
 	{
 		if (size > _capacity) {
+			if (buffer && ft::storage_traits<A>::reallocate(allocator, buffer, _capacity, size)) {
+				FT_STAT(_stats.allocated((size - _capacity) * sizeof(value_type)));
+				FT_STAT(++_stats.reallocations);
+				_capacity = size;
+				return;
+			}
 			T* tmp = allocator.allocate(size);
-			for (size_t i = 0; i < _size; ++i)
-				tmp[i] = buffer[i];
+			FT_STAT(_stats.allocated(size * sizeof(value_type)));
+			FT_STAT(_stats.reallocations += (buffer != 0));
+			FT_STAT(_stats.copied_bytes += _size * sizeof(value_type));
+			try {
+				relocate(tmp, buffer, _size, relocatable());
+			} catch (...) {
+				allocator.deallocate(tmp, size);
+				throw;
+			}
 			if (buffer) allocator.deallocate(buffer, _capacity);
 			_capacity = size;
 			buffer = tmp;
@@ -149,37 +196,19 @@ public:
 
 	void insert( iterator pos, size_type count, const T& value )
 	{
-		int index = pos - begin();
-		size_t max_size = _size + count;
-
-		if (count >= _capacity)
-		{
-			reserve(_capacity + count);
-			_size = max_size;
-		} else
-		{
-			while (_size != max_size)
-			{
-				if (_size == _capacity)
-					reserve(_capacity * 2);
-				_size++;
-			}
-		}
-        for (int i = _size; i >= 0; --i)
-		{
-            if (i == index + count-1)
-			{
-                for (; count > 0; --count, --i)
-                    buffer[i] = value;
-                return;
-            }
-            buffer[i] = buffer[i - count];
-        }
+		size_type index = pos - begin();
+		if (!count)
+			return;
+		value_type copy(value);
+		if (_size + count > _capacity)
+			reserve(std::max(_size + count, _capacity * 2));
+		insert_fill(index, count, copy, relocatable());
+		_size += count;
 	};
 
 	iterator insert(iterator pos, const_reference value)
 	{
-		int index = pos - begin();
+		size_type index = pos - begin();
 		this->insert(pos, 1, value);
 		return (iterator(buffer + index));
 	};
@@ -188,84 +217,124 @@ public:
 	typename ft::enable_if<!ft::is_integral<InputIt>::value, void>::type
 	insert( iterator pos, InputIt first, InputIt last)
 	{
-		size_t range_size = last - first;
-		if (!validate_iterator_values(first, last, range_size))
-			throw std::exception();
-		size_t new_size = _size + range_size;
-
-		int last_index = (pos - begin()) + range_size - 1;
-		if (range_size >= _capacity)
-		{
-			reserve(_capacity + range_size);
-			_size = new_size;
-		} else
-		{
-			while (_size != new_size)
-			{
-				if (_size == _capacity)
-					reserve(_capacity * 2);
-				_size++;
-			}
-		}
-		for (int i = _size - 1; i >= 0; --i)
-		{
-			if (i == last_index)
-			{
-				for (; range_size > 0; --range_size, --i)
-					buffer[i] = *--last;
-				return;
-			}
-			buffer[i] = buffer[i - range_size];
-		}
+		insert_range(pos - begin(), first, last, typename std::iterator_traits<InputIt>::iterator_category());
 	};
 
 	iterator erase( iterator pos )
 	{
-		int index = pos - begin();
-		for (size_t i = index; i < _size; ++i)
-			buffer[i] = buffer[i + 1];
-		_size--;
-		return pos;
+		return erase(pos, pos + 1);
 	}
 
 	iterator erase( iterator first, iterator last )
 	{
-		int start = first - begin();
-		int end = last - begin();
-		int offset = end - start;
+		size_type start = first - begin();
+		size_type offset = last - first;
 
+		if (offset)
+			erase_range(start, offset, relocatable());
 		_size -= offset;
-		for (size_t i = start; i < _size; ++i)
-			buffer[i] = buffer[i + offset];
-		return buffer + start;
+		return iterator(buffer + start);
 	}
 
 	void push_back( const_reference value )
 	{
-		if (_size == _capacity)
+		if (_size == _capacity) {
+			value_type copy(value);
 			(!_capacity) ? this->reserve(1) : this->reserve(_capacity * 2);
-		buffer[_size] = value;
+			allocator.construct(buffer + _size, copy);
+		} else
+			allocator.construct(buffer + _size, value);
 		++_size;
 	};
 
+#if __cplusplus >= 201103L
+	void push_back( value_type&& value )
+	{
+		this->emplace_back(std::move(value));
+	};
+
+	template <class... Args>
+	reference emplace_back( Args&&... args )
+	{
+		if (_size == _capacity) {
+			value_type tmp(std::forward<Args>(args)...);
+			(!_capacity) ? this->reserve(1) : this->reserve(_capacity * 2);
+			std::allocator_traits<A>::construct(allocator, buffer + _size, std::move(tmp));
+		} else
+			std::allocator_traits<A>::construct(allocator, buffer + _size, std::forward<Args>(args)...);
+		++_size;
+		return back();
+	};
+
+	template <class... Args>
+	iterator emplace( iterator pos, Args&&... args )
+	{
+		size_type index = pos - begin();
+		this->emplace_back(std::forward<Args>(args)...);
+		std::rotate(buffer + index, buffer + _size - 1, buffer + _size);
+		return iterator(buffer + index);
+	};
+#endif
+
 	void pop_back() {
-		allocator.destroy(buffer + _size);
 		_size--;
+		allocator.destroy(buffer + _size);
 	}
 
 	void resize( size_type count, T value = T() )
 	{
-		if (count < _size)
-		{
-			while (_size != count)
-				pop_back();
-		} else
-		{
-			if (_capacity * 2 < count)
-				reserve(count);
-			while (_size != count)
-				push_back(value);
+		if (count <= _size) {
+			for (size_type i = count; i < _size; ++i)
+				allocator.destroy(buffer + i);
+		} else {
+			reserve_append(count - _size);
+			fill_construct(buffer + _size, count - _size, value);
 		}
+		_size = count;
+	}
+
+	// Like resize, but new elements are left uninitialized, for a buffer that is
+	// about to be overwritten (by read(2), say). Trivially copyable types only.
+	void resize_uninitialized( size_type count )
+	{
+		typedef char resize_uninitialized_requires_trivially_copyable[ft::is_trivially_copyable<T>::value ? 1 : -1];
+		(void)sizeof(resize_uninitialized_requires_trivially_copyable);
+		if (count > _size)
+			reserve_append(count - _size);
+		_size = count;
+	}
+
+	// Grows by count uninitialized elements and returns a pointer to the first.
+	pointer append_uninitialized( size_type count )
+	{
+		size_type old_size = _size;
+		resize_uninitialized(_size + count);
+		return buffer + old_size;
+	}
+
+	// Appends count elements constructed from successive calls to gen().
+	template <class Generator>
+	void append( size_type count, Generator gen )
+	{
+		reserve_append(count);
+		size_type i = 0;
+		try {
+			for (; i < count; ++i)
+				allocator.construct(buffer + _size + i, gen());
+		} catch (...) {
+			while (i)
+				allocator.destroy(buffer + _size + --i);
+			throw;
+		}
+		_size += count;
+	}
+
+	// Forward ranges are measured first, so the buffer grows at most once.
+	template <class InputIt>
+	typename ft::enable_if<!ft::is_integral<InputIt>::value, void>::type
+	append( InputIt first, InputIt last )
+	{
+		insert_range(_size, first, last, typename std::iterator_traits<InputIt>::iterator_category());
 	}
 
 	void swap( Vector& other )
@@ -279,89 +348,255 @@ public:
 
 	friend bool operator== (const Vector &lhs, const Vector &rhs)
 	{
-		if (lhs.size() != rhs.size()) return false;
-		for (size_t i = 0; i < lhs.size(); ++i)
-		{
-			if (lhs[i] == rhs[i])
-				continue;
-			return false;
-		}
-		return true;
+		return lhs.size() == rhs.size() && ft::simd_mismatch(lhs.data(), rhs.data(), lhs.size()) == lhs.size();
 	};
 
 	friend bool operator!= (const Vector &lhs, const Vector &rhs) { return !(lhs == rhs); };
 
-	friend bool operator<= (const Vector &lhs, const Vector &rhs)
+	friend bool operator< (const Vector &lhs, const Vector &rhs)
 	{
-		if (lhs.size() < rhs.size()) return true;
-		if (lhs.size() > rhs.size()) return false;
+		return ft::simd_less(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+	};
+
+	friend bool operator> (const Vector &lhs, const Vector &rhs) { return rhs < lhs; };
+	friend bool operator<= (const Vector &lhs, const Vector &rhs) { return !(rhs < lhs); };
+	friend bool operator>= (const Vector &lhs, const Vector &rhs) { return !(lhs < rhs); };
+
+private:
 
-		for (size_t i = 0; i < lhs.size(); ++i) {
-			if (lhs[i] == rhs[i])
-				continue;
-			return lhs[i] < rhs[i];
+	// Makes room for count more elements, growing geometrically.
+	void reserve_append(size_type count) {
+		if (_size + count > _capacity)
+			reserve(std::max(_size + count, _capacity * 2));
+	}
+
+	void copy_construct(pointer dst, const_pointer src, size_type n) {
+		copy_construct(dst, src, n, ft::integral_constant<bool, ft::is_trivially_copyable<T>::value>());
+	}
+
+	void copy_construct(pointer dst, const_pointer src, size_type n, ft::integral_constant<bool, true>) {
+		if (n)
+			std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(value_type));
+	}
+
+	void copy_construct(pointer dst, const_pointer src, size_type n, ft::integral_constant<bool, false>) {
+		size_type i = 0;
+		try {
+			for (; i < n; ++i)
+				allocator.construct(dst + i, src[i]);
+		} catch (...) {
+			while (i)
+				allocator.destroy(dst + --i);
+			throw;
 		}
-		return true;
-	};
+	}
 
-	friend bool operator>= (const Vector &lhs, const Vector &rhs) {
-		if (lhs.size() < rhs.size()) return false;
-		if (lhs.size() > rhs.size()) return true;
+	void move_construct(pointer dst, pointer src, size_type n) {
+		size_type i = 0;
+		try {
+			for (; i < n; ++i)
+				allocator.construct(dst + i, FT_MOVE_IF_NOEXCEPT(src[i]));
+		} catch (...) {
+			while (i)
+				allocator.destroy(dst + --i);
+			throw;
+		}
+	}
 
-		for (size_t i = 0; i < lhs.size(); ++i)
-		{
-			if (lhs[i] == rhs[i])
-				continue;
-			return lhs[i] > rhs[i];
+	template <class InputIt>
+	void construct_range(pointer dst, InputIt first, InputIt last) {
+		pointer cur = dst;
+		try {
+			for (; first != last; ++first, ++cur)
+				allocator.construct(cur, *first);
+		} catch (...) {
+			while (cur != dst)
+				allocator.destroy(--cur);
+			throw;
 		}
-		return true;
-	};
+	}
 
-	friend bool operator< (const Vector &lhs, const Vector &rhs)
-	{
-		if (lhs.size() < rhs.size()) return true;
-		if (lhs.size() > rhs.size()) return false;
-
-		for (size_t i = 0; i < lhs.size(); ++i)
-		{
-			if (lhs[i] == rhs[i])
-				continue;
-			return lhs[i] < rhs[i];
+	void construct_range(pointer dst, pointer first, pointer last)
+		{ copy_construct(dst, first, last - first); }
+	void construct_range(pointer dst, const_pointer first, const_pointer last)
+		{ copy_construct(dst, first, last - first); }
+	void construct_range(pointer dst, iterator first, iterator last)
+		{ copy_construct(dst, first.base(), last - first); }
+	void construct_range(pointer dst, const_iterator first, const_iterator last)
+		{ copy_construct(dst, first.base(), last - first); }
+
+	void relocate(pointer dst, pointer src, size_type n, ft::integral_constant<bool, true>) {
+		copy_construct(dst, src, n, ft::integral_constant<bool, true>());
+	}
+
+	void relocate(pointer dst, pointer src, size_type n, ft::integral_constant<bool, false>) {
+		move_construct(dst, src, n);
+		for (size_type i = 0; i < n; ++i)
+			allocator.destroy(src + i);
+	}
+
+	void insert_fill(size_type index, size_type count, const_reference value, ft::integral_constant<bool, true>) {
+		size_type tail = _size - index;
+		std::memmove(static_cast<void*>(buffer + index + count), static_cast<void*>(buffer + index), tail * sizeof(value_type));
+		try {
+			fill_construct(buffer + index, count, value);
+		} catch (...) {
+			std::memmove(static_cast<void*>(buffer + index), static_cast<void*>(buffer + index + count), tail * sizeof(value_type));
+			throw;
 		}
-		return false;
-	};
+	}
 
-	friend bool operator> (const Vector &lhs, const Vector &rhs)
-	{
-		if (lhs.size() > rhs.size()) return true;
-		if (lhs.size() < rhs.size()) return false;
-
-		for (size_t i = 0; i < lhs.size(); ++i)
-		{
-			if (lhs[i] == rhs[i])
-				continue;
-			return lhs[i] > rhs[i];
+	// [high, end) and [_size, low) are the slots built past _size so far; if a
+	// move or copy throws they are destroyed and the caller leaves _size as it was.
+	void insert_fill(size_type index, size_type count, const_reference value, ft::integral_constant<bool, false>) {
+		size_type end = _size + count;
+		size_type high = end;
+		size_type low = _size;
+		try {
+			for (size_type i = _size; i-- > index;) {
+				if (i + count >= _size) {
+					allocator.construct(buffer + i + count, FT_MOVE(buffer[i]));
+					high = i + count;
+				} else
+					buffer[i + count] = FT_MOVE(buffer[i]);
+			}
+			for (size_type i = index; i < index + count; ++i) {
+				if (i < _size)
+					buffer[i] = value;
+				else {
+					allocator.construct(buffer + i, value);
+					low = i + 1;
+				}
+			}
+		} catch (...) {
+			while (high != end)
+				allocator.destroy(buffer + high++);
+			while (low != _size)
+				allocator.destroy(buffer + --low);
+			throw;
 		}
-		return false;
-	};
+	}
 
-private:
+	template <class ForwardIt>
+	void assign_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+		difference_type range_size = std::distance(first, last);
+		if (range_size < 0) throw std::length_error("Vector");
+		this->clear();
+		this->reserve(range_size);
+		construct_range(buffer, first, last);
+		_size = range_size;
+	}
+
+	template <class InputIt>
+	void assign_range(InputIt first, InputIt last, std::input_iterator_tag) {
+		this->clear();
+		for (; first != last; ++first)
+			this->push_back(*first);
+	}
+
+	template <class ForwardIt>
+	void insert_range(size_type index, ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+		size_type count = std::distance(first, last);
+		if (!count)
+			return;
+		if (_size + count > _capacity && !relocatable::value) {
+			insert_range_realloc(index, first, last, count);
+			return;
+		}
+		if (_size + count > _capacity)
+			reserve(std::max(_size + count, _capacity * 2));
+		insert_range_inplace(index, first, last, count, relocatable());
+		_size += count;
+	}
+
+	template <class InputIt>
+	void insert_range(size_type index, InputIt first, InputIt last, std::input_iterator_tag) {
+		size_type old_size = _size;
+		try {
+			for (; first != last; ++first)
+				this->push_back(*first);
+		} catch (...) {
+			while (_size != old_size)
+				pop_back();
+			throw;
+		}
+		std::rotate(buffer + index, buffer + old_size, buffer + _size);
+	}
+
+	template <class ForwardIt>
+	void insert_range_inplace(size_type index, ForwardIt first, ForwardIt last, size_type count, ft::integral_constant<bool, true>) {
+		size_type tail = _size - index;
+		std::memmove(static_cast<void*>(buffer + index + count), static_cast<void*>(buffer + index), tail * sizeof(value_type));
+		try {
+			construct_range(buffer + index, first, last);
+		} catch (...) {
+			std::memmove(static_cast<void*>(buffer + index), static_cast<void*>(buffer + index + count), tail * sizeof(value_type));
+			throw;
+		}
+	}
+
+	template <class ForwardIt>
+	void insert_range_inplace(size_type index, ForwardIt first, ForwardIt last, size_type count, ft::integral_constant<bool, false>) {
+		construct_range(buffer + _size, first, last);
+		std::rotate(buffer + index, buffer + _size, buffer + _size + count);
+	}
+
+	template <class ForwardIt>
+	void insert_range_realloc(size_type index, ForwardIt first, ForwardIt last, size_type count) {
+		size_type new_capacity = std::max(_size + count, _capacity * 2);
+		pointer tmp = allocator.allocate(new_capacity);
+		FT_STAT(_stats.allocated(new_capacity * sizeof(value_type)));
+		FT_STAT(++_stats.reallocations);
+		FT_STAT(_stats.copied_bytes += _size * sizeof(value_type));
+		size_type built = 0;
+		try {
+			construct_range(tmp + index, first, last);
+			built = count;
+			move_construct(tmp, buffer, index);
+			built += index;
+			move_construct(tmp + index + count, buffer + index, _size - index);
+		} catch (...) {
+			if (built)
+				for (size_type i = 0; i < count; ++i)
+					allocator.destroy(tmp + index + i);
+			if (built > count)
+				for (size_type i = 0; i < index; ++i)
+					allocator.destroy(tmp + i);
+			allocator.deallocate(tmp, new_capacity);
+			throw;
+		}
+		for (size_type i = 0; i < _size; ++i)
+			allocator.destroy(buffer + i);
+		if (buffer) allocator.deallocate(buffer, _capacity);
+		buffer = tmp;
+		_capacity = new_capacity;
+		_size += count;
+	}
+
+	void erase_range(size_type start, size_type count, ft::integral_constant<bool, true>) {
+		for (size_type i = start; i < start + count; ++i)
+			allocator.destroy(buffer + i);
+		std::memmove(static_cast<void*>(buffer + start), static_cast<void*>(buffer + start + count),
+					 (_size - start - count) * sizeof(value_type));
+	}
+
+	void erase_range(size_type start, size_type count, ft::integral_constant<bool, false>) {
+		for (size_type i = start; i + count < _size; ++i)
+			buffer[i] = FT_MOVE(buffer[i + count]);
+		for (size_type i = _size - count; i < _size; ++i)
+			allocator.destroy(buffer + i);
+	}
 
-	template<class InputIt>
-	typename ft::enable_if<!ft::is_integral<InputIt>::value, bool>::type
-	validate_iterator_values(InputIt first, InputIt last, size_t range) {
-		pointer reserved_buffer;
-		reserved_buffer = allocator.allocate(range);
-		bool result = true;
-		size_t i = 0;
-
-		for (;first != last; ++first, ++i) {
-			try { reserved_buffer[i] = *first; }
-			catch (...)
-				{ result = false; break; }
+	void fill_construct(pointer dst, size_type n, const_reference value) {
+		size_type i = 0;
+		try {
+			for (; i < n; ++i)
+				allocator.construct(dst + i, value);
+		} catch (...) {
+			while (i)
+				allocator.destroy(dst + --i);
+			throw;
 		}
-		allocator.deallocate(reserved_buffer, range);
-		return result;
 	}
 };
 }
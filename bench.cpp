@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <stack>
+#include <string>
+#include <vector>
+#include <time.h>
+
+#include "Vector.hpp"
+#include "Set.hpp"
+#include "Stack.hpp"
+#include "Map.hpp"
+
+// Times ft:: containers against their std:: equivalents and prints one JSON
+// object with a record per (container, operation, key type, size).
+// Usage: ./bench_ft [max_size]   (sizes run from 1e3 up to max_size, default 1e7)
+
+namespace {
+	struct Large {
+		long	id;
+		char	payload[120];
+
+		Large(long i = 0) : id(i) { std::memset(payload, (int)(i & 0x7f), sizeof(payload)); }
+		bool operator<(const Large &o) const { return id < o.id; }
+		bool operator>(const Large &o) const { return id > o.id; }
+		bool operator<=(const Large &o) const { return id <= o.id; }
+		bool operator>=(const Large &o) const { return id >= o.id; }
+		bool operator==(const Large &o) const { return id == o.id; }
+		bool operator!=(const Large &o) const { return id != o.id; }
+	};
+
+	template <class K> K make_key(long i);
+	template <> int make_key<int>(long i) { return (int)i; }
+	template <> std::string make_key<std::string>(long i) {
+		char buf[32];
+		std::snprintf(buf, sizeof(buf), "key-%020ld", i);
+		return buf;
+	}
+	template <> Large make_key<Large>(long i) { return Large(i); }
+
+	template <class K> const char *key_name();
+	template <> const char *key_name<int>() { return "int"; }
+	template <> const char *key_name<std::string>() { return "string"; }
+	template <> const char *key_name<Large>() { return "large"; }
+
+	volatile std::size_t	sink;
+	bool					first_record = true;
+
+	double now() {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ts.tv_sec * 1e9 + ts.tv_nsec;
+	}
+
+	void record(const char *container, const char *op, const char *key, std::size_t n,
+				std::size_t ops, double ft_ns, double std_ns) {
+		std::printf("%s\n    {\"container\": \"%s\", \"op\": \"%s\", \"key\": \"%s\", \"n\": %lu, "
+					"\"ft_ns_per_op\": %.3f, \"std_ns_per_op\": %.3f, \"ratio\": %.3f}",
+					first_record ? "" : ",", container, op, key, (unsigned long)n,
+					ft_ns / ops, std_ns / ops, std_ns > 0 ? ft_ns / std_ns : 0.0);
+		first_record = false;
+		std::fflush(stdout);
+	}
+
+	// Positional Vector inserts/erases are O(n) each, so only this many are timed.
+	std::size_t shifting_ops(std::size_t n) { return std::min<std::size_t>(n, 1000); }
+
+	template <class V, class K>
+	struct vector_bench {
+		static double push_back(const std::vector<K> &keys) {
+			double t = now();
+			V v;
+			for (std::size_t i = 0; i < keys.size(); ++i)
+				v.push_back(keys[i]);
+			sink = v.size();
+			return now() - t;
+		}
+
+		static double insert(const std::vector<K> &keys) {
+			V v(keys.begin(), keys.end());
+			std::size_t ops = shifting_ops(keys.size());
+			double t = now();
+			for (std::size_t i = 0; i < ops; ++i)
+				v.insert(v.begin() + (i * 7919) % v.size(), keys[i]);
+			sink = v.size();
+			return now() - t;
+		}
+
+		static double erase(const std::vector<K> &keys) {
+			V v(keys.begin(), keys.end());
+			std::size_t ops = shifting_ops(keys.size());
+			double t = now();
+			for (std::size_t i = 0; i < ops; ++i)
+				v.erase(v.begin() + (i * 7919) % v.size());
+			sink = v.size();
+			return now() - t;
+		}
+
+		static double iterate(const std::vector<K> &keys) {
+			V v(keys.begin(), keys.end());
+			double t = now();
+			std::size_t hits = 0;
+			for (typename V::iterator it = v.begin(); it != v.end(); ++it)
+				hits += (*it == keys[0]);
+			sink = hits;
+			return now() - t;
+		}
+	};
+
+	template <class M> typename M::value_type make_value(const typename M::key_type &k, ft::integral_constant<bool, true>)
+		{ return typename M::value_type(k, 0); }
+	template <class M> typename M::value_type make_value(const typename M::key_type &k, ft::integral_constant<bool, false>)
+		{ return k; }
+
+	// Shared by maps (value = pair<key, int>) and sets (value = key).
+	template <class M, class K, bool IsMap>
+	struct tree_bench {
+		static typename M::value_type value(const K &k) { return make_value<M>(k, ft::integral_constant<bool, IsMap>()); }
+
+		static void fill(M &m, const std::vector<K> &keys) {
+			for (std::size_t i = 0; i < keys.size(); ++i)
+				m.insert(value(keys[i]));
+		}
+
+		static double insert_random(const std::vector<K> &shuffled, const std::vector<K> &) {
+			double t = now();
+			M m;
+			fill(m, shuffled);
+			sink = m.size();
+			return now() - t;
+		}
+
+		static double insert_sorted(const std::vector<K> &, const std::vector<K> &sorted) {
+			double t = now();
+			M m;
+			fill(m, sorted);
+			sink = m.size();
+			return now() - t;
+		}
+
+		static double insert_hinted(const std::vector<K> &, const std::vector<K> &sorted) {
+			double t = now();
+			M m;
+			for (std::size_t i = 0; i < sorted.size(); ++i)
+				m.insert(m.end(), value(sorted[i]));
+			sink = m.size();
+			return now() - t;
+		}
+
+		static double find(const std::vector<K> &shuffled, const std::vector<K> &) {
+			M m;
+			fill(m, shuffled);
+			double t = now();
+			std::size_t hits = 0;
+			for (std::size_t i = 0; i < shuffled.size(); ++i)
+				hits += m.find(shuffled[i]) != m.end();
+			sink = hits;
+			return now() - t;
+		}
+
+		static double lower_bound(const std::vector<K> &shuffled, const std::vector<K> &) {
+			M m;
+			fill(m, shuffled);
+			double t = now();
+			std::size_t hits = 0;
+			for (std::size_t i = 0; i < shuffled.size(); ++i)
+				hits += m.lower_bound(shuffled[i]) != m.end();
+			sink = hits;
+			return now() - t;
+		}
+
+		static double erase(const std::vector<K> &shuffled, const std::vector<K> &) {
+			M m;
+			fill(m, shuffled);
+			double t = now();
+			for (std::size_t i = 0; i < shuffled.size(); ++i)
+				m.erase(shuffled[i]);
+			sink = m.size();
+			return now() - t;
+		}
+
+		static double iterate(const std::vector<K> &shuffled, const std::vector<K> &) {
+			M m;
+			fill(m, shuffled);
+			double t = now();
+			std::size_t count = 0;
+			for (typename M::iterator it = m.begin(); it != m.end(); ++it)
+				++count;
+			sink = count;
+			return now() - t;
+		}
+
+		static double copy(const std::vector<K> &shuffled, const std::vector<K> &) {
+			M m;
+			fill(m, shuffled);
+			double t = now();
+			M c(m);
+			sink = c.size();
+			return now() - t;
+		}
+
+		static double clear(const std::vector<K> &shuffled, const std::vector<K> &) {
+			M m;
+			fill(m, shuffled);
+			double t = now();
+			m.clear();
+			sink = m.size();
+			return now() - t;
+		}
+	};
+
+	template <class S, class K>
+	double stack_push_pop(const std::vector<K> &keys) {
+		double t = now();
+		S s;
+		for (std::size_t i = 0; i < keys.size(); ++i)
+			s.push(keys[i]);
+		while (!s.empty())
+			s.pop();
+		sink = s.size();
+		return now() - t;
+	}
+
+	template <class K>
+	void run(std::size_t n) {
+		std::vector<K> sorted;
+		sorted.reserve(n);
+		for (std::size_t i = 0; i < n; ++i)
+			sorted.push_back(make_key<K>((long)i));
+		std::vector<K> shuffled(sorted);
+		std::srand(42);
+		for (std::size_t i = n; i > 1; --i)
+			std::swap(shuffled[i - 1], shuffled[(std::size_t)std::rand() % i]);
+		const char *key = key_name<K>();
+
+		typedef vector_bench<ft::Vector<K>, K>	ft_vec;
+		typedef vector_bench<std::vector<K>, K>	std_vec;
+		record("Vector", "push_back", key, n, n, ft_vec::push_back(shuffled), std_vec::push_back(shuffled));
+		record("Vector", "insert", key, n, shifting_ops(n), ft_vec::insert(shuffled), std_vec::insert(shuffled));
+		record("Vector", "erase", key, n, shifting_ops(n), ft_vec::erase(shuffled), std_vec::erase(shuffled));
+		record("Vector", "iterate", key, n, n, ft_vec::iterate(shuffled), std_vec::iterate(shuffled));
+
+		typedef tree_bench<ft::Map<K, int>, K, true>	ft_map;
+		typedef tree_bench<std::map<K, int>, K, true>	std_map;
+		typedef tree_bench<ft::Set<K>, K, false>		ft_set;
+		typedef tree_bench<std::set<K>, K, false>		std_set;
+		static const struct {
+			const char	*name;
+			double		(*ft_map)(const std::vector<K> &, const std::vector<K> &);
+			double		(*std_map)(const std::vector<K> &, const std::vector<K> &);
+			double		(*ft_set)(const std::vector<K> &, const std::vector<K> &);
+			double		(*std_set)(const std::vector<K> &, const std::vector<K> &);
+		} tree_ops[] = {
+			{ "insert_random", ft_map::insert_random, std_map::insert_random, ft_set::insert_random, std_set::insert_random },
+			{ "insert_sorted", ft_map::insert_sorted, std_map::insert_sorted, ft_set::insert_sorted, std_set::insert_sorted },
+			{ "insert_hinted", ft_map::insert_hinted, std_map::insert_hinted, ft_set::insert_hinted, std_set::insert_hinted },
+			{ "find", ft_map::find, std_map::find, ft_set::find, std_set::find },
+			{ "lower_bound", ft_map::lower_bound, std_map::lower_bound, ft_set::lower_bound, std_set::lower_bound },
+			{ "erase", ft_map::erase, std_map::erase, ft_set::erase, std_set::erase },
+			{ "iterate", ft_map::iterate, std_map::iterate, ft_set::iterate, std_set::iterate },
+			{ "copy", ft_map::copy, std_map::copy, ft_set::copy, std_set::copy },
+			{ "clear", ft_map::clear, std_map::clear, ft_set::clear, std_set::clear }
+		};
+		for (std::size_t i = 0; i < sizeof(tree_ops) / sizeof(tree_ops[0]); ++i) {
+			record("Map", tree_ops[i].name, key, n, n, tree_ops[i].ft_map(shuffled, sorted), tree_ops[i].std_map(shuffled, sorted));
+			record("Set", tree_ops[i].name, key, n, n, tree_ops[i].ft_set(shuffled, sorted), tree_ops[i].std_set(shuffled, sorted));
+		}
+
+		record("Stack", "push_pop", key, n, n, stack_push_pop<ft::Stack<K> >(shuffled), stack_push_pop<std::stack<K> >(shuffled));
+	}
+}
+
+int main(int argc, char **argv) {
+	std::size_t max_size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+	// Large keys are capped so that both copies of a 1e7-element tree fit in memory.
+	std::size_t max_large = std::min<std::size_t>(max_size, 1000000);
+
+	std::printf("{\n  \"unit\": \"ns_per_op\",\n  \"results\": [");
+	for (std::size_t n = 1000; n <= max_size; n *= 10) {
+		run<int>(n);
+		run<std::string>(n);
+		if (n <= max_large)
+			run<Large>(n);
+	}
+	std::printf("\n  ]\n}\n");
+	return 0;
+}
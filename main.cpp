@@ -2,8 +2,418 @@
 #include "Set.hpp"
 #include "Stack.hpp"
 #include "Map.hpp"
+#include "RingQueue.hpp"
+#include "ConcurrentStack.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <time.h>
+#include <stdexcept>
+#include <pthread.h>
+#include <sched.h>
+
+// Copying or assigning throws once `countdown` copies have been made; 0 never throws.
+struct throwing_copy
+{
+    static int  countdown;
+    static int  live;
+    int         value;
+
+    throwing_copy(int v = 0) : value(v) { ++live; }
+    throwing_copy(const throwing_copy &other) : value(other.value) { tick(); ++live; }
+    throwing_copy &operator=(const throwing_copy &other) { tick(); value = other.value; return *this; }
+    ~throwing_copy() { --live; }
+
+    static void tick()
+    {
+        if (countdown && --countdown == 0)
+            throw std::runtime_error("throwing_copy");
+    }
+};
+int throwing_copy::countdown = 0;
+int throwing_copy::live = 0;
+
+// Full and empty queue, then a batch round trip that wraps around the buffer.
+template <class Mode>
+static void ring_queue_basic_test()
+{
+    ft::RingQueue<int, Mode> q(3);
+    int out = -1;
+    assert(q.capacity() == 4 && q.empty() && !q.pop(out) && out == -1);
+    for (int i = 0; i < 4; ++i)
+        assert(q.push(i));
+    assert(!q.push(4) && q.size() == 4);
+    for (int i = 0; i < 4; ++i)
+        assert(q.pop(out) && out == i);
+    assert(q.empty() && !q.pop(out));
+
+    int in[6] = { 10, 11, 12, 13, 14, 15 };
+    int got[6] = { 0 };
+    assert(q.push_n(in, 3) == 3 && q.pop_n(got, 2) == 2);
+    assert(q.push_n(in + 3, 3) == 3 && q.size() == 4);
+    assert(q.pop_n(got + 2, 6) == 4 && q.empty());
+    for (int i = 0; i < 6; ++i)
+        assert(got[i] == in[i]);
+    assert(q.pop_n(got, 6) == 0);
+}
+
+static void ring_queue_throw_test()
+{
+    {
+        // A push whose copy throws must not wedge the queue.
+        ft::RingQueue<throwing_copy, ft::ring_mpmc> q(4);
+        throwing_copy a(1), b(2), c(3), out;
+        throwing_copy::countdown = 2;
+        assert(q.push(a));
+        try { q.push(b); assert(false); } catch (std::runtime_error &) {}
+        assert(q.push(c) && q.size() == 3);
+        assert(q.pop(out) && out.value == 1 && q.pop(out) && out.value == 3 && !q.pop(out));
+        for (int i = 0; i < 10; ++i)
+            assert(q.push(a) && q.pop(out) && out.value == 1);
+        throwing_copy::countdown = 1;
+        try { q.push(b); assert(false); } catch (std::runtime_error &) {}
+        assert(q.push(a));
+    }
+    {
+        // pop_n keeps what it had not taken yet when an assignment throws.
+        ft::RingQueue<throwing_copy, ft::ring_spsc> q(8);
+        for (int i = 0; i < 5; ++i)
+            assert(q.push(throwing_copy(i)));
+        throwing_copy out[5];
+        throwing_copy::countdown = 3;
+        try { q.pop_n(out, 5); assert(false); } catch (std::runtime_error &) {}
+        assert(q.size() == 3 && out[1].value == 1);
+        assert(q.pop_n(out, 5) == 3 && out[0].value == 2 && out[2].value == 4 && q.empty());
+    }
+    assert(throwing_copy::live == 0);
+}
+
+template <class Queue>
+struct ring_worker
+{
+    Queue   *queue;
+    long    count;      // values each producer pushes
+    long    *popped;    // shared count of values taken by all consumers
+    long    total;      // values all consumers take between them
+    long    sum;        // of the values this consumer took
+
+    static void *produce(void *arg)
+    {
+        ring_worker *w = static_cast<ring_worker *>(arg);
+        for (long i = 1; i <= w->count; ++i)
+            while (!w->queue->push(i))
+                sched_yield();
+        return 0;
+    }
+
+    static void *consume(void *arg)
+    {
+        ring_worker *w = static_cast<ring_worker *>(arg);
+        long value;
+        while (__atomic_load_n(w->popped, __ATOMIC_RELAXED) < w->total)
+            if (w->queue->pop(value)) {
+                w->sum += value;
+                __atomic_add_fetch(w->popped, 1, __ATOMIC_RELAXED);
+            } else
+                sched_yield();
+        return 0;
+    }
+};
+
+// `producers` threads push 1..count each while `consumers` threads pop; every
+// value must come out exactly once.
+template <class Mode>
+static void ring_queue_thread_test(int producers, int consumers, long count)
+{
+    typedef ft::RingQueue<long, Mode>   queue;
+    typedef ring_worker<queue>          worker;
+
+    queue q(64);
+    long popped = 0;
+    worker workers[8];
+    pthread_t threads[8];
+    for (int i = 0; i < producers + consumers; ++i) {
+        worker w = { &q, count, &popped, producers * count, 0 };
+        workers[i] = w;
+        pthread_create(&threads[i], 0, i < producers ? worker::produce : worker::consume, &workers[i]);
+    }
+    long sum = 0;
+    for (int i = 0; i < producers + consumers; ++i) {
+        pthread_join(threads[i], 0);
+        sum += workers[i].sum;
+    }
+    assert(popped == producers * count && q.empty());
+    assert(sum == producers * (count * (count + 1) / 2));
+}
+
+static void ring_queue_test()
+{
+    ring_queue_basic_test<ft::ring_single>();
+    ring_queue_basic_test<ft::ring_spsc>();
+    ring_queue_basic_test<ft::ring_mpmc>();
+    ring_queue_throw_test();
+    ring_queue_thread_test<ft::ring_spsc>(1, 1, 20000);
+    ring_queue_thread_test<ft::ring_mpmc>(4, 4, 5000);
+}
+
+static void concurrent_stack_test()
+{
+    {
+        ft::ConcurrentStack<int> s;
+        int out = -1;
+        assert(s.empty() && !s.pop(out) && !s.top(out) && out == -1);
+        s.reserve(4);
+        for (int i = 0; i < 5; ++i)
+            s.push(i);
+        assert(s.top(out) && out == 4);
+        for (int i = 4; i >= 0; --i)
+            assert(s.pop(out) && out == i);
+        assert(s.empty() && !s.pop(out));
+    }
+    {
+        // pop leaves the element on the stack when handing it out throws.
+        ft::ConcurrentStack<throwing_copy> s;
+        s.push(throwing_copy(1));
+        s.push(throwing_copy(2));
+        throwing_copy out;
+        throwing_copy::countdown = 1;
+        try { s.pop(out); assert(false); } catch (std::runtime_error &) {}
+        assert(s.pop(out) && out.value == 2 && s.pop(out) && out.value == 1 && s.empty());
+    }
+    assert(throwing_copy::live == 0);
+}
+
+struct stack_worker
+{
+    ft::ConcurrentStack<long>   *stack;
+    long                        count;
+    long                        sum;    // of the values this thread popped
+
+    // Pushes 1..count, popping one value after each push, so nodes keep moving
+    // between the stack and its free list while other threads do the same.
+    static void *run(void *arg)
+    {
+        stack_worker *w = static_cast<stack_worker *>(arg);
+        long value;
+        for (long i = 1; i <= w->count; ++i) {
+            w->stack->push(i);
+            while (!w->stack->pop(value))
+                sched_yield();
+            w->sum += value;
+        }
+        return 0;
+    }
+};
+
+static void concurrent_stack_thread_test(int thread_count, long count)
+{
+    ft::ConcurrentStack<long> s;
+    stack_worker workers[8];
+    pthread_t threads[8];
+    for (int i = 0; i < thread_count; ++i) {
+        stack_worker w = { &s, count, 0 };
+        workers[i] = w;
+        pthread_create(&threads[i], 0, stack_worker::run, &workers[i]);
+    }
+    long sum = 0;
+    for (int i = 0; i < thread_count; ++i) {
+        pthread_join(threads[i], 0);
+        sum += workers[i].sum;
+    }
+    assert(s.empty() && sum == thread_count * (count * (count + 1) / 2));
+}
+
+// end() moves only when a container that never held an element gets its own
+// tree; after that it survives inserts, erases and clear().
+template <class Container>
+static void tree_end_test(const typename Container::value_type &a, const typename Container::value_type &b)
+{
+    Container c;
+    assert(c.begin() == c.end() && c.size() == 0);
+    c.insert(a);
+    typename Container::iterator end = c.end();
+    c.insert(b);
+    assert(end == c.end());
+    c.erase(c.begin());
+    assert(end == c.end() && --end != c.end());
+    end = c.end();
+    c.erase(c.begin());
+    assert(c.empty() && end == c.end() && c.begin() == end);
+    c.insert(b);
+    assert(end == c.end());
+    c.clear();
+    assert(end == c.end());
+    c.insert(a);
+    assert(end == c.end() && ++c.begin() == end);
+}
+
+static void tree_end_tests()
+{
+    tree_end_test<ft::Map<int, int> >(ft::make_pair(1, 10), ft::make_pair(2, 20));
+    tree_end_test<ft::Set<int> >(1, 2);
+}
+
+static void count_task(void *arg)
+{
+    __atomic_add_fetch(static_cast<long *>(arg), 1, __ATOMIC_RELAXED);
+}
+
+static void throw_task(void *)
+{
+    throw std::runtime_error("task failed");
+}
+
+static void sleep_task(void *arg)
+{
+    __atomic_store_n(static_cast<bool *>(arg), true, __ATOMIC_RELEASE);
+    usleep(100000);
+}
+
+struct fork_task
+{
+    ft::ThreadPool  *pool;
+    long            *counter;
+
+    // Forks ten counting tasks from inside a worker and joins them there.
+    static void run(void *arg)
+    {
+        fork_task *f = static_cast<fork_task *>(arg);
+        ft::ThreadPool::task_group group;
+        for (int i = 0; i < 10; ++i)
+            f->pool->submit(group, count_task, f->counter);
+        f->pool->wait(group);
+    }
+};
+
+static double thread_cpu_seconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int twice(int x)
+{
+    return x * 2;
+}
+
+static void thread_pool_test(std::size_t threads)
+{
+    ft::ThreadPool pool(threads);
+    assert(pool.size() == threads);
+
+    long counter = 0;
+    ft::ThreadPool::task_group group;
+    for (int i = 0; i < 1000; ++i)
+        pool.submit(group, count_task, &counter);
+    pool.wait(group);
+    assert(counter == 1000);
+
+    counter = 0;
+    fork_task forks[20];
+    for (int i = 0; i < 20; ++i) {
+        fork_task f = { &pool, &counter };
+        forks[i] = f;
+        pool.submit(group, fork_task::run, &forks[i]);
+    }
+    pool.wait(group);
+    assert(counter == 200);
+
+    // The first failure reaches wait(), once every task has finished.
+    counter = 0;
+    pool.submit(group, throw_task, 0);
+    for (int i = 0; i < 10; ++i)
+        pool.submit(group, count_task, &counter);
+    try { pool.wait(group); assert(false); } catch (std::runtime_error &) {}
+    assert(counter == 10 && group.pending == 0);
+
+    // A thread waiting on a task that a worker is running sleeps instead of
+    // spinning.
+    if (threads) {
+        bool started = false;
+        pool.submit(group, sleep_task, &started);
+        while (!__atomic_load_n(&started, __ATOMIC_ACQUIRE))
+            usleep(1000);
+        double start = thread_cpu_seconds();
+        pool.wait(group);
+        assert(thread_cpu_seconds() - start < 0.05);
+    }
+
+    const int n = 100000;
+    ft::Vector<int> v;
+    for (int i = 0; i < n; ++i)
+        v.push_back(rand() % n);
+    ft::Vector<int> sorted(v);
+    std::sort(sorted.begin(), sorted.end());
+    long sum = 0;
+    for (int i = 0; i < n; ++i)
+        sum += v[i];
+    assert(ft::parallel_reduce(pool, v.begin(), v.end(), 0L) == sum);
+    ft::Vector<int> doubled(n);
+    ft::parallel_transform(pool, v.begin(), v.end(), doubled.begin(), twice);
+    for (int i = 0; i < n; ++i)
+        assert(doubled[i] == v[i] * 2);
+    ft::parallel_sort(pool, v.begin(), v.end());
+    assert(ft::equal(v.begin(), v.end(), sorted.begin()));
+}
+
+#ifdef FT_LARGE_TESTS
+#include <climits>
+
+// Index and iterator arithmetic past INT_MAX. Needs a little over 2 GB, so it
+// only runs in the `make large` build.
+static void large_vector_test()
+{
+    typedef ft::Vector<char>::size_type         size_type;
+    typedef ft::Vector<char>::difference_type   difference_type;
+    typedef ft::Vector<char>::iterator          iterator;
+
+    const size_type n = (size_type)INT_MAX + 100;
+    ft::Vector<char> v;
+    v.reserve(n + 16);
+    v.resize_uninitialized(n);
+    assert(v.size() == n);
+    v[0] = 'a';
+    v[(size_type)INT_MAX + 1] = 'm';
+    v[n - 1] = 'z';
+
+    assert(v.end() - v.begin() == (difference_type)n);
+    iterator mid = v.begin() + ((difference_type)INT_MAX + 1);
+    assert(*mid == 'm');
+    assert(mid - v.begin() == (difference_type)INT_MAX + 1);
+    assert(mid[-((difference_type)INT_MAX + 1)] == 'a');
+    iterator last = v.begin();
+    last += (difference_type)n - 1;
+    assert(*last == 'z' && last == v.end() - 1);
+    assert((v.end() - ((difference_type)INT_MAX + 100)) == v.begin());
+    assert(v.at(n - 1) == 'z');
+
+    iterator pos = v.insert(v.end() - 1, 'y');
+    assert(pos - v.begin() == (difference_type)n - 1);
+    assert(v.size() == n + 1 && v[n - 1] == 'y' && v[n] == 'z');
+    v.insert(v.end(), (size_type)3, 'x');
+    assert(v.size() == n + 4 && v[n + 3] == 'x');
+    pos = v.erase(v.begin() + ((difference_type)n - 1));
+    assert(*pos == 'z' && v.size() == n + 3);
+    v.erase(v.end() - 3, v.end());
+    assert(v.size() == n && v.back() == 'z');
+    v.resize(n - 1);
+    assert(v.size() == n - 1 && v[(size_type)INT_MAX + 1] == 'm');
+}
+#endif
 
 int main()
 {
+    tree_end_tests();
+    ring_queue_test();
+    concurrent_stack_test();
+    concurrent_stack_thread_test(4, 20000);
+    thread_pool_test(0);
+    thread_pool_test(3);
+#ifdef FT_LARGE_TESTS
+    large_vector_test();
+#endif
     return 0;
-}
\ No newline at end of file
+}